@@ -0,0 +1,186 @@
+#ifndef CPP_ARCHITECT_ROADMAP_01_MODERN_CPP_Week01_SMART_PTR_OBJECT_POOL_H_
+#define CPP_ARCHITECT_ROADMAP_01_MODERN_CPP_Week01_SMART_PTR_OBJECT_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "smart_ptr.hpp"
+
+// 对象池 ObjectPool<T>：对象析构后，内存不还给 malloc，而是挂回空闲链表，下次 New 直接复用。
+//
+// 结构 (两级)：
+//   1. 线程本地空闲链表 (thread_local)：New / Delete 的热路径只碰自己线程的链表，不加锁、没有原子操作
+//   2. 全局溢出链表 (mutex)：本地链表攒得太多时，整批 (kBatchSize 个) 交给全局；
+//      本地链表空了，先从全局整批拿一串，全局也空了才向系统申请一整块 (kBatchSize 个槽位)
+// 锁只在"整批搬运"时才拿，均摊到每次 New / Delete 上几乎可以忽略。
+//
+// A 线程 New 出来的对象可以在 B 线程 Delete：它只是挂到 B 的本地链表上，以后由 B 复用。
+//
+// 每个类型 T 只有一个池 (Instance())。这样删除器 PoolDeleter 不需要保存池指针，是一个空类，
+// SmartPtr<T, PoolDeleter<T>> 依然恰好是一个指针的大小。
+//
+// 注意：池只增不减，申请过的内存要到程序结束 (池析构) 才还给系统。
+template <typename T>
+class ObjectPool {
+public:
+  // 每批搬运的槽位数，本地链表最多攒 2 * kBatchSize 个
+  static constexpr size_t kBatchSize = 64;
+
+  static ObjectPool& Instance() {
+    static ObjectPool pool;
+    return pool;
+  }
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  // 取一个空闲槽位，原地构造 T
+  template <typename... Args>
+  T* New(Args&&... args) {
+    LocalCache& cache = local_cache_;
+    if (cache.head == nullptr) {
+      Refill(cache);
+    }
+    Slot* slot = cache.head;
+    cache.head = slot->next;
+    --cache.count;
+
+    try {
+      return ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      // 构造函数抛异常：槽位原样放回去，不泄漏
+      slot->next = cache.head;
+      cache.head = slot;
+      ++cache.count;
+      throw;
+    }
+  }
+
+  // 析构对象，把槽位挂回当前线程的空闲链表
+  void Delete(T* object) {
+    if (object == nullptr) {
+      return;
+    }
+    object->~T();
+
+    // storage 是 Slot 的第一个成员 (union)，对象地址就是槽位地址
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    LocalCache& cache = local_cache_;
+    slot->next = cache.head;
+    cache.head = slot;
+    if (++cache.count >= 2 * kBatchSize) {
+      Spill(cache);
+    }
+  }
+
+  // 向系统申请过的槽位总数 (所有线程)
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return blocks_.size() * kBatchSize;
+  }
+
+private:
+  // 空闲时存 next 指针，使用中存对象本身。两者不会同时存在，所以放进 union，零额外开销
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  // 一串空闲槽位
+  struct Batch {
+    Slot* head;
+    size_t count;
+  };
+
+  // 线程本地的空闲链表。线程退出时把剩下的槽位整串交还给全局，留给其他线程用
+  struct LocalCache {
+    Slot* head = nullptr;
+    size_t count = 0;
+
+    ~LocalCache() {
+      if (head != nullptr) {
+        ObjectPool::Instance().PushBatch(Batch{head, count});
+      }
+    }
+  };
+
+  ObjectPool() = default;
+
+  // 本地链表空了：从全局拿一串，全局也空了就申请一整块新槽位
+  void Refill(LocalCache& cache) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_batches_.empty()) {
+        Batch batch = free_batches_.back();
+        free_batches_.pop_back();
+        cache.head = batch.head;
+        cache.count = batch.count;
+        return;
+      }
+    }
+
+    // 向系统申请放在锁外：一次 new 出 kBatchSize 个槽位，串成链表
+    auto block = std::make_unique<Slot[]>(kBatchSize);
+    for (size_t i = 0; i + 1 < kBatchSize; ++i) {
+      block[i].next = &block[i + 1];
+    }
+    block[kBatchSize - 1].next = nullptr;
+    Slot* head = block.get();
+
+    // 先交给 blocks_ 再挂到本地链表：push_back 扩容抛异常时 unique_ptr 会释放这块内存，
+    // 此时 cache 还没指向它，本地链表保持原样 (空的)，异常照常传给 New 的调用方
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      blocks_.push_back(std::move(block));
+    }
+    cache.head = head;
+    cache.count = kBatchSize;
+  }
+
+  // 本地链表太长：把前 kBatchSize 个槽位切下来交给全局 (留一半在本地，避免 New/Delete 交替时来回搬)
+  void Spill(LocalCache& cache) {
+    Slot* head = cache.head;
+    Slot* tail = head;
+    for (size_t i = 1; i < kBatchSize; ++i) {
+      tail = tail->next;
+    }
+    cache.head = tail->next;
+    cache.count -= kBatchSize;
+    tail->next = nullptr;
+    PushBatch(Batch{head, kBatchSize});
+  }
+
+  void PushBatch(Batch batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_batches_.push_back(batch);
+  }
+
+  static inline thread_local LocalCache local_cache_;
+
+  mutable std::mutex mutex_;
+  std::vector<Batch> free_batches_;              // 全局溢出链表 (按批存放)
+  std::vector<std::unique_ptr<Slot[]>> blocks_;  // 向系统申请的所有内存块，池析构时统一释放
+};
+
+// 删除器：不 delete，而是把对象还给池。空类，SmartPtr 依然是一个指针的大小
+template <typename T>
+struct PoolDeleter {
+  void operator()(T* object) const { ObjectPool<T>::Instance().Delete(object); }
+};
+
+template <typename T>
+using PooledPtr = SmartPtr<T, PoolDeleter<T>>;
+
+// 用法类似 std::make_unique：auto conn = MakePooled<Connection>(fd);
+template <typename T, typename... Args>
+PooledPtr<T> MakePooled(Args&&... args) {
+  return PooledPtr<T>(ObjectPool<T>::Instance().New(std::forward<Args>(args)...));
+}
+
+static_assert(sizeof(PooledPtr<int>) == sizeof(int*));
+
+#endif  // CPP_ARCHITECT_ROADMAP_01_MODERN_CPP_Week01_SMART_PTR_OBJECT_POOL_H_
@@ -1,26 +1,68 @@
 #ifndef CPP_ARCHITECT_ROADMAP_01_MODERN_CPP_Week01_SMART_PTR_SMART_PTR_H_
 #define CPP_ARCHITECT_ROADMAP_01_MODERN_CPP_Week01_SMART_PTR_SMART_PTR_H_
 
-#include <utility> // std::exchange 
+#include <cstddef> // std::nullptr_t
+#include <type_traits>
+#include <utility> // std::exchange
+
+// ------------------------- Level 5: 自定义删除器 -------------------------
+// 默认删除器：单个对象用 delete，数组用 delete[]。
+// 它是一个空类 (没有成员变量)，配合 [[no_unique_address]] 不占 SmartPtr 的任何空间
+template <typename T>
+struct DefaultDelete {
+  void operator()(T* ptr) const { delete ptr; }
+};
+
+template <typename T>
+struct DefaultDelete<T[]> {
+  void operator()(T* ptr) const { delete[] ptr; }
+};
+
+// SmartPtr 实际保存的"指针"类型：
+//   - 默认是 T*
+//   - 如果删除器里定义了 pointer 类型，就用它 (同 std::unique_ptr)。
+//     这样 fd 这类"不是指针的句柄"也能被托管，例如 pointer 是一个用 -1 表示空的 int 包装
+template <typename T, typename Deleter, typename = void>
+struct SmartPtrPointer {
+  using type = T*;
+};
+
+template <typename T, typename Deleter>
+struct SmartPtrPointer<T, Deleter, std::void_t<typename Deleter::pointer>> {
+  using type = typename Deleter::pointer;
+};
 
 // Google Style: 类名使用 PascalCase
-template <typename T> 
+template <typename T, typename Deleter = DefaultDelete<T>>
 class SmartPtr {
 public:
+  using pointer = typename SmartPtrPointer<T, Deleter>::type;
+  using element_type = T;
+  using deleter_type = Deleter;
+
   // ptr参数有默认值nullptr
-  explicit SmartPtr(T* ptr = nullptr) : ptr_(ptr) {}
+  explicit SmartPtr(pointer ptr = nullptr) : ptr_(ptr) {}
+
+  // 带状态的删除器 (例如记住 mmap 区域长度的 munmap 删除器) 从这里传进来
+  SmartPtr(pointer ptr, Deleter deleter) : ptr_(ptr), deleter_(std::move(deleter)) {}
 
-  ~SmartPtr() { 
+  ~SmartPtr() {
     if (ptr_) {
-      delete ptr_;
+      deleter_(ptr_);   // 不再写死 delete，交给删除器
       ptr_ = nullptr;  // 防止悬垂指针
     }
   }
 
-  T* Get() {
+  pointer Get() const {
     return ptr_;
   }
 
+  Deleter& GetDeleter() { return deleter_; }
+  const Deleter& GetDeleter() const { return deleter_; }
+
+  // if (ptr) { ... }
+  explicit operator bool() const { return static_cast<bool>(ptr_); }
+
   // ------------------------- Level 2: 运算符重载 -------------------------
   // 1. 解引用运算符
   // 返回 T& (引用)，允许用户直接操作对象本身
@@ -32,7 +74,7 @@ public:
   // 2. 箭头运算符
   // 返回 T* (指针)，这是 C++ 编译器处理 -> 的硬性规定
   // 它会让 basket->func() 自动转发为 ptr_->func()
-  T* operator->() const {
+  pointer operator->() const {
     return ptr_;
   }
 
@@ -53,12 +95,12 @@ public:
   // 目的：创建一个新对象，直接接管 other 的资源
   // 注意：构造函数没有返回值！
   // 构造函数不需要检查 self-assignment，因为新对象不可能等于旧对象
-  SmartPtr(SmartPtr&& other) noexcept {
+  SmartPtr(SmartPtr&& other) noexcept : deleter_(std::move(other.deleter_)) {
     // [偷窃]: 把别人的指针拿过来
     ptr_ = other.ptr_;
     // [销毁现场]: 把别人的指针置空，防止他析构时把球炸了
     other.ptr_ = nullptr;
-    
+
     // 构造函数结束，this 对象就诞生了
   }
 
@@ -71,25 +113,102 @@ public:
       return *this;
     }
 
-    // [清理门户]: 
-    // 如果我手里原本拿着球，我必须先把它销毁，否则就内存泄漏了。
+    // [清理门户] + [偷窃]:
+    // 如果我手里原本拿着球，我必须先把它销毁，否则就内存泄漏了。Reset 会用我自己的删除器销毁旧的球
+    Reset(other.Release());
+
+    // 删除器跟着资源一起走：新接管的球将来要用 other 的删除器销毁
+    deleter_ = std::move(other.deleter_);
+
+    // 返回我自己 (*this)
+    return *this;
+  }
+
+  // ------------------------- Level 6: 手动交出 / 替换资源 -------------------------
+  // Release：放弃所有权，返回原始指针，自己变成空。调用者负责销毁它 (不会调用删除器)
+  pointer Release() {
+    return std::exchange(ptr_, nullptr);
+  }
+
+  // Reset：换成 ptr (默认换成空)，销毁旧的资源。
+  // 先换指针、再删旧对象：即使旧对象的析构函数又访问到了这个 SmartPtr，看到的也已经是新值
+  void Reset(pointer ptr = nullptr) {
+    pointer old = std::exchange(ptr_, ptr);
+    if (old) {
+      deleter_(old);
+    }
+  }
+
+private:
+  // Google Style: 成员变量以小写加下划线结尾
+  pointer ptr_;
+
+  // 空的删除器 (DefaultDelete、fclose 包装等) 加上 [[no_unique_address]] 后不占空间，
+  // 和 ptr_ 共用地址，SmartPtr 依然恰好是一个指针的大小 (零开销)
+  [[no_unique_address]] Deleter deleter_;
+};
+
+// ------------------------- Level 7: 数组特化 -------------------------
+// SmartPtr<Ball[]> balls(new Ball[3]);
+// 与单对象版本的区别：
+//   1. 默认删除器是 delete[] (用 delete 释放 new[] 出来的数组是未定义行为)
+//   2. 没有 * 和 ->，改为提供 operator[]
+template <typename T, typename Deleter>
+class SmartPtr<T[], Deleter> {
+public:
+  using pointer = typename SmartPtrPointer<T, Deleter>::type;
+  using element_type = T;
+  using deleter_type = Deleter;
+
+  explicit SmartPtr(pointer ptr = nullptr) : ptr_(ptr) {}
+  SmartPtr(pointer ptr, Deleter deleter) : ptr_(ptr), deleter_(std::move(deleter)) {}
+
+  ~SmartPtr() {
     if (ptr_) {
-      delete ptr_;   // <---------- 会触发析构
+      deleter_(ptr_);
+      ptr_ = nullptr;
     }
+  }
 
-    // [偷窃]: 接管资源
-    ptr_ = other.ptr_;
+  pointer Get() const { return ptr_; }
+  Deleter& GetDeleter() { return deleter_; }
+  const Deleter& GetDeleter() const { return deleter_; }
+  explicit operator bool() const { return static_cast<bool>(ptr_); }
 
-    // [销毁现场]: 把源对象置空 ---- 解除绑定（已经移交给 this->ptr_ 了）
-    other.ptr_ = nullptr;
+  // 下标访问：不做越界检查 (与原生数组一致)
+  T& operator[](size_t index) const { return ptr_[index]; }
 
-    // 返回我自己 (*this)
+  SmartPtr(const SmartPtr&) = delete;
+  SmartPtr& operator=(const SmartPtr&) = delete;
+
+  SmartPtr(SmartPtr&& other) noexcept
+      : ptr_(std::exchange(other.ptr_, nullptr)), deleter_(std::move(other.deleter_)) {}
+
+  SmartPtr& operator=(SmartPtr&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+    Reset(other.Release());
+    deleter_ = std::move(other.deleter_);
     return *this;
   }
 
+  pointer Release() { return std::exchange(ptr_, nullptr); }
+
+  void Reset(pointer ptr = nullptr) {
+    pointer old = std::exchange(ptr_, ptr);
+    if (old) {
+      deleter_(old);
+    }
+  }
+
 private:
-  // Google Style: 成员变量以小写加下划线结尾
-  T* ptr_;
+  pointer ptr_;
+  [[no_unique_address]] Deleter deleter_;
 };
 
-#endif  // CPP_ARCHITECT_ROADMAP_01_MODERN_CPP_Week01_SMART_PTR_SMART_PTR_H_
\ No newline at end of file
+// 无状态删除器 = 零开销：和原生指针一样大
+static_assert(sizeof(SmartPtr<int>) == sizeof(int*));
+static_assert(sizeof(SmartPtr<int[]>) == sizeof(int*));
+
+#endif  // CPP_ARCHITECT_ROADMAP_01_MODERN_CPP_Week01_SMART_PTR_SMART_PTR_H_
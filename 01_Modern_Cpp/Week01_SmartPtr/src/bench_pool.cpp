@@ -0,0 +1,78 @@
+// src/bench_pool.cpp
+// 多线程高频创建 / 销毁对象：SmartPtr + new/delete vs SmartPtr + ObjectPool
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "object_pool.hpp"
+#include "smart_ptr.hpp"
+
+// 模拟一个请求对象：几百字节，构造时写一点数据
+struct Request {
+  explicit Request(int request_id) : id(request_id) { std::memset(header, 'x', 16); }
+
+  int id;
+  char header[240];
+};
+
+const int kOpsPerThread = 2000000;
+const int kLiveObjects = 256;  // 每个线程同时持有的对象数 (模拟正在处理中的请求)
+
+// 每个线程维护一个"窗口"，随机替换其中一个对象：一次销毁 + 一次创建
+template <typename Ptr, typename MakeFn>
+void Churn(int seed, MakeFn make, long long* sink) {
+  std::vector<Ptr> live;
+  live.reserve(kLiveObjects);
+  for (int i = 0; i < kLiveObjects; ++i) {
+    live.push_back(make(i));
+  }
+
+  std::mt19937 rng(seed);
+  long long sum = 0;
+  for (int i = 0; i < kOpsPerThread; ++i) {
+    Ptr& slot = live[rng() % kLiveObjects];
+    sum += slot->id;
+    slot = make(i);  // 移动赋值：旧对象交给删除器，新对象接管
+  }
+  *sink = sum;
+}
+
+template <typename Ptr, typename MakeFn>
+void Run(const char* name, int num_threads, MakeFn make) {
+  std::vector<long long> sinks(num_threads);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t] { Churn<Ptr>(t, make, &sinks[t]); });
+  }
+  for (auto& th : threads) th.join();
+  auto end = std::chrono::steady_clock::now();
+
+  long long sink = 0;
+  for (long long s : sinks) sink += s;
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "  " << name << " threads=" << num_threads << ": "
+            << num_threads * kOpsPerThread / seconds / 1e6 << " M create+destroy/s"
+            << "  (sink=" << sink << ")" << std::endl;
+}
+
+int main() {
+  std::cout << "=== Object Pool Benchmark (sizeof(Request) = " << sizeof(Request) << ") ===" << std::endl;
+  std::cout << "sizeof(SmartPtr<Request>) = " << sizeof(SmartPtr<Request>)
+            << ", sizeof(PooledPtr<Request>) = " << sizeof(PooledPtr<Request>) << std::endl;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  for (int threads : {1, 4, 8}) {
+    Run<SmartPtr<Request>>("new/delete ", threads,
+                           [](int id) { return SmartPtr<Request>(new Request(id)); });
+    Run<PooledPtr<Request>>("ObjectPool ", threads,
+                            [](int id) { return MakePooled<Request>(id); });
+  }
+
+  std::cout << "pool capacity: " << ObjectPool<Request>::Instance().capacity() << " slots" << std::endl;
+  return 0;
+}
@@ -1,7 +1,13 @@
+#include <cstdio>
 #include <iostream>
 #include <utility> 
 #include <string>
 
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <unistd.h>    // close
+
+#include "object_pool.hpp"
 #include "smart_ptr.hpp"  // 预处理器在编译之前，会把 smart_ptr.hpp 里的所有代码，原封不动地复制并替换掉这一行
 
 class Ball {
@@ -25,6 +31,41 @@ private:
   std::string name_;
 };
 
+// ------------------------- Level 5 用到的删除器 -------------------------
+// 1. FILE*：用 fclose 而不是 delete。空类，不占空间
+struct FileCloser {
+  void operator()(FILE* file) const {
+    std::cout << "  fclose(" << file << ")" << std::endl;
+    std::fclose(file);
+  }
+};
+
+// 2. mmap 区域：munmap 需要知道长度，所以这是一个"有状态"的删除器，SmartPtr 会多占一个 size_t
+struct MunmapDeleter {
+  size_t length;
+  void operator()(char* addr) const {
+    std::cout << "  munmap(" << static_cast<void*>(addr) << ", " << length << ")" << std::endl;
+    munmap(addr, length);
+  }
+};
+
+// 3. 文件描述符：fd 不是指针，用 -1 表示"空"。删除器里定义 pointer 类型，SmartPtr 就保存它而不是 int*
+struct FdCloser {
+  struct pointer {
+    int fd = -1;
+
+    pointer() = default;
+    pointer(std::nullptr_t) {}  // SmartPtr 用 nullptr 表示"空"
+    explicit pointer(int value) : fd(value) {}
+    explicit operator bool() const { return fd >= 0; }
+  };
+
+  void operator()(pointer handle) const {
+    std::cout << "  close(" << handle.fd << ")" << std::endl;
+    close(handle.fd);
+  }
+};
+
 int main() {
   std::cout << "=== 开始测试 Level 2 ===" << std::endl;
 
@@ -116,5 +157,58 @@ int main() {
   }
   ptr3->Bounce(); // ptr3 现在指向 Original
 
+  std::cout << "\n=== 开始测试 Level 5: 自定义删除器 ===" << std::endl;
+  {
+    SmartPtr<FILE, FileCloser> file(std::tmpfile());
+    std::fputs("hello", file.Get());
+
+    const size_t kRegionSize = 4096;
+    void* region = mmap(nullptr, kRegionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    SmartPtr<char, MunmapDeleter> mapping(static_cast<char*>(region), MunmapDeleter{kRegionSize});
+    mapping.Get()[0] = 'x';
+
+    SmartPtr<int, FdCloser> fd(FdCloser::pointer(open("/dev/null", O_RDONLY)));
+    std::cout << "fd = " << fd.Get().fd << std::endl;
+
+    // 无状态删除器零开销，有状态删除器才多占它自己的那几个字节
+    std::cout << "sizeof(Ball*) = " << sizeof(Ball*)
+              << ", sizeof(SmartPtr<Ball>) = " << sizeof(SmartPtr<Ball>)
+              << ", sizeof(SmartPtr<FILE, FileCloser>) = " << sizeof(file)
+              << ", sizeof(SmartPtr<char, MunmapDeleter>) = " << sizeof(mapping) << std::endl;
+    std::cout << "--- 离开作用域 (按声明的逆序释放) ---" << std::endl;
+  }
+
+  std::cout << "\n=== 开始测试 Level 6: Release / Reset ===" << std::endl;
+  {
+    SmartPtr<Ball> owner(new Ball("Reset Ball"));
+    owner.Reset(new Ball("Replacement"));  // 旧球立刻被析构
+
+    Ball* raw = owner.Release();  // 交出所有权，owner 变空，不会析构
+    std::cout << "Release 之后 owner 为空: " << (owner ? "否" : "是") << std::endl;
+    delete raw;                   // 由调用者负责
+
+    owner.Reset();                // 空指针上 Reset 什么都不做
+  }
+
+  std::cout << "\n=== 开始测试 Level 7: 数组特化 ===" << std::endl;
+  {
+    // new[] 必须配 delete[]：SmartPtr<Ball[]> 的默认删除器就是 delete[]，3 个球都会被析构
+    SmartPtr<Ball[]> balls(new Ball[3]);
+    balls[1].Bounce();
+  }
+
+  std::cout << "\n=== 开始测试 Level 8: 对象池 ===" << std::endl;
+  {
+    // PoolDeleter 不 delete，而是把内存挂回池的空闲链表；下一个对象直接复用同一块内存
+    void* first_address = nullptr;
+    {
+      PooledPtr<Ball> ball = MakePooled<Ball>("Pooled Ball 1");
+      first_address = ball.Get();
+    }  // 析构 Ball，内存回到池里 (没有 free)
+    PooledPtr<Ball> ball = MakePooled<Ball>("Pooled Ball 2");
+    std::cout << "复用了同一块内存: " << (ball.Get() == first_address ? "是" : "否")
+              << ", sizeof(PooledPtr<Ball>) = " << sizeof(ball) << std::endl;
+  }
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef Week02_PERFORMANCE_INCLUDE_FIXED_STRING_HPP_
+#define Week02_PERFORMANCE_INCLUDE_FIXED_STRING_HPP_
+
+#include <cstddef>
+#include <stdexcept> // for std::length_error
+#include <type_traits>
+
+#include "my_string_view.hpp"
+
+// 定长字符串 FixedString<N>：最多 N 个字符，全部存放在对象内部，没有指针、没有堆内存。
+//
+// 所有操作都是 constexpr 的，所以它可以：
+//   1. 在编译期算出哈希 / 做比较：constexpr size_t kGet = FixedString("GET").Hash();
+//   2. 直接当非类型模板参数 (C++20 NTTP)：
+//        template <FixedString kName> struct Command { ... };
+//        Command<"GET"> get;   // 字面量通过推导指引变成 FixedString<3>
+//   3. 做 switch 分派：Hash() 在编译期和运行期的结果完全一致 (见 string_simd.hpp 的 ConstexprHash)，
+//        switch (token.Hash()) { case FixedString("GET").Hash(): ... }
+//      运行期只算一次哈希，然后是一张跳转表；命中后还要再比较一次内容，防止哈希碰撞
+//
+// 与 MyString / MyStringView 的转换：
+//   - FixedString -> MyStringView：隐式转换，零拷贝
+//   - FixedString -> MyString    ：MyString s(fixed);  (经过视图深拷贝，和 MyString(view) 一样是 explicit 的)
+//   - MyString / MyStringView -> FixedString：FixedString<16> f(str);  超过 N 个字符时抛 std::length_error
+//     (在 constexpr 上下文里，抛异常会直接变成编译错误)
+//
+// 注意：NTTP 要求"结构化类型"(structural type)，所有成员必须是 public 的，
+// 所以这里和 StringPiece 一样用 public 的数据成员，而不是带下划线的私有成员。
+template <size_t N>
+struct FixedString {
+  // 最多能放的字符数 (不含 \0)
+  static constexpr size_t kCapacity = N;
+
+  // ------------------------- 构造 -------------------------
+  constexpr FixedString() = default;
+
+  // 从字符串字面量构造："GET" 的类型是 const char[4]，推导指引 (见类外) 把它变成 FixedString<3>
+  // 不加 explicit：让 Command<"GET"> 这种写法直接生效
+  constexpr FixedString(const char (&str)[N + 1]) {
+    for (size_t i = 0; i < N; ++i) {
+      buf[i] = str[i];
+    }
+    length = std::char_traits<char>::length(str);  // 字面量里可能有更早的 \0
+  }
+
+  // 从视图 (以及通过隐式转换的 MyString) 复制。放不下时抛 std::length_error
+  constexpr explicit FixedString(MyStringView view) {
+    if (view.size() > N) {
+      throw std::length_error("FixedString: source longer than capacity");
+    }
+    for (size_t i = 0; i < view.size(); ++i) {
+      buf[i] = view[i];
+    }
+    length = view.size();
+  }
+
+  // ------------------------- 访问器 -------------------------
+  constexpr size_t size() const { return length; }
+  static constexpr size_t capacity() { return N; }
+  constexpr bool empty() const { return length == 0; }
+  constexpr const char* data() const { return buf; }
+  constexpr const char* c_str() const { return buf; }
+  constexpr const char* begin() const { return buf; }
+  constexpr const char* end() const { return buf + length; }
+  constexpr char operator[](size_t i) const { return buf[i]; }
+
+  // 隐式转换成视图：Find / Split / Trim 等只读操作都交给 MyStringView
+  constexpr operator MyStringView() const { return MyStringView(buf, length); }
+
+  // ------------------------- 比较 / 哈希 -------------------------
+  // 与 MyStringView::Hash / MyString::Hash 完全相同，编译期和运行期结果一致
+  constexpr size_t Hash() const { return MyStringView(*this).Hash(); }
+
+  // 字典序比较 (按无符号字节)，返回 <0 / 0 / >0
+  constexpr int Compare(MyStringView other) const {
+    if (!std::is_constant_evaluated()) {
+      return MyStringView(*this).Compare(other);
+    }
+    size_t common = length < other.size() ? length : other.size();
+    for (size_t i = 0; i < common; ++i) {
+      unsigned char lhs = static_cast<unsigned char>(buf[i]);
+      unsigned char rhs = static_cast<unsigned char>(other[i]);
+      if (lhs != rhs) {
+        return lhs < rhs ? -1 : 1;
+      }
+    }
+    return length < other.size() ? -1 : (length > other.size() ? 1 : 0);
+  }
+
+  // 不同容量的 FixedString、MyStringView、C 字符串、MyString (都会转换成视图) 都可以直接比较
+  friend constexpr bool operator==(const FixedString& lhs, MyStringView rhs) {
+    return MyStringView(lhs) == rhs;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const FixedString& str) {
+    return os << MyStringView(str);
+  }
+
+  // ------------------------- 数据 (public：NTTP 的要求) -------------------------
+  // 未使用的部分始终为 0：两个内容相同的 FixedString 逐字节相等，作为模板参数时才是"同一个值"
+  char buf[N + 1] = {};
+  size_t length = 0;
+};
+
+// 推导指引：FixedString("GET") / Command<"GET"> 推导出 FixedString<3> (去掉末尾的 \0)
+template <size_t N>
+FixedString(const char (&)[N]) -> FixedString<N - 1>;
+
+// 编译期自检：constexpr 构造、比较、哈希，以及作为 NTTP 使用
+static_assert(FixedString("GET").size() == 3);
+static_assert(FixedString("GET") == MyStringView("GET"));
+static_assert(FixedString("GET").Compare("POST") < 0);
+static_assert(FixedString("GET").Hash() == MyStringView("GET").Hash());
+static_assert(FixedString<8>(MyStringView("PUT")) == FixedString("PUT"));
+static_assert(std::is_trivially_copyable_v<FixedString<16>>);
+
+#endif // Week02_PERFORMANCE_INCLUDE_FIXED_STRING_HPP_
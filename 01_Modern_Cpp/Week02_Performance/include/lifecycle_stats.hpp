@@ -0,0 +1,119 @@
+#ifndef Week02_PERFORMANCE_INCLUDE_LIFECYCLE_STATS_HPP_
+#define Week02_PERFORMANCE_INCLUDE_LIFECYCLE_STATS_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+
+// 编译期开关：默认 Debug 开启、Release (定义了 NDEBUG) 关闭。
+// 也可以在编译命令里用 -DLIFECYCLE_STATS=0/1 强制指定。
+#ifndef LIFECYCLE_STATS
+#ifdef NDEBUG
+#define LIFECYCLE_STATS 0
+#else
+#define LIFECYCLE_STATS 1
+#endif
+#endif
+
+// 每个类型一套独立的生命周期计数器 (LifecycleStats<MyString>、LifecycleStats<Foo> 互不干扰)。
+// 替代在构造函数里 std::cout << std::endl 的做法：
+//   - std::endl 每次都 flush，一个对象一次 write 系统调用，日志本身的开销远大于拷贝本身；
+//   - 这里只是一条 relaxed 的 fetch_add，关闭时 if constexpr 直接把它从代码里删掉 (零成本)。
+template <typename T>
+class LifecycleStats {
+public:
+  static constexpr bool kEnabled = LIFECYCLE_STATS;
+
+  // 某一时刻的计数快照
+  struct Snapshot {
+    uint64_t constructions = 0;    // 所有构造 (默认/有参/拷贝/移动)
+    uint64_t copies = 0;           // 拷贝构造 + 拷贝赋值
+    uint64_t moves = 0;            // 移动构造 + 移动赋值
+    uint64_t heap_allocations = 0; // 堆分配次数
+    uint64_t bytes_allocated = 0;  // 堆分配总字节数
+    uint64_t bytes_copied = 0;     // memcpy 复制的总字节数
+  };
+
+  static void OnConstruct() {
+    if constexpr (kEnabled) Add(counters_.constructions);
+  }
+
+  static void OnCopy() {
+    if constexpr (kEnabled) Add(counters_.copies);
+  }
+
+  static void OnMove() {
+    if constexpr (kEnabled) Add(counters_.moves);
+  }
+
+  static void OnAllocate(size_t bytes) {
+    if constexpr (kEnabled) {
+      Add(counters_.heap_allocations);
+      Add(counters_.bytes_allocated, bytes);
+    }
+  }
+
+  static void OnBytesCopied(size_t bytes) {
+    if constexpr (kEnabled) Add(counters_.bytes_copied, bytes);
+  }
+
+  static Snapshot Get() {
+    Snapshot s;
+    if constexpr (kEnabled) {
+      s.constructions = counters_.constructions.load(std::memory_order_relaxed);
+      s.copies = counters_.copies.load(std::memory_order_relaxed);
+      s.moves = counters_.moves.load(std::memory_order_relaxed);
+      s.heap_allocations = counters_.heap_allocations.load(std::memory_order_relaxed);
+      s.bytes_allocated = counters_.bytes_allocated.load(std::memory_order_relaxed);
+      s.bytes_copied = counters_.bytes_copied.load(std::memory_order_relaxed);
+    }
+    return s;
+  }
+
+  static void Reset() {
+    if constexpr (kEnabled) {
+      counters_.constructions.store(0, std::memory_order_relaxed);
+      counters_.copies.store(0, std::memory_order_relaxed);
+      counters_.moves.store(0, std::memory_order_relaxed);
+      counters_.heap_allocations.store(0, std::memory_order_relaxed);
+      counters_.bytes_allocated.store(0, std::memory_order_relaxed);
+      counters_.bytes_copied.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  static void PrintSummary(const char* type_name, std::ostream& os = std::cout) {
+    if constexpr (!kEnabled) {
+      os << "[" << type_name << "] lifecycle stats disabled (LIFECYCLE_STATS=0)\n";
+    } else {
+      Snapshot s = Get();
+      os << "[" << type_name << "] constructions=" << s.constructions
+         << " copies=" << s.copies
+         << " moves=" << s.moves
+         << " heap_allocations=" << s.heap_allocations
+         << " bytes_allocated=" << s.bytes_allocated
+         << " bytes_copied=" << s.bytes_copied << "\n";
+    }
+  }
+
+private:
+  // 每个计数器独占一条 cache line，多线程同时更新不同计数器时不会 false sharing
+  struct Counters {
+    alignas(64) std::atomic<uint64_t> constructions{0};
+    alignas(64) std::atomic<uint64_t> copies{0};
+    alignas(64) std::atomic<uint64_t> moves{0};
+    alignas(64) std::atomic<uint64_t> heap_allocations{0};
+    alignas(64) std::atomic<uint64_t> bytes_allocated{0};
+    alignas(64) std::atomic<uint64_t> bytes_copied{0};
+  };
+
+  // 只统计次数，不用于线程间同步，relaxed 足够
+  static void Add(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+    counter.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  // 所有访问都包在 if constexpr (kEnabled) 里：关闭时 counters_ 从未被 odr-use，
+  // inline static 模板成员根本不会被实例化
+  inline static Counters counters_;
+};
+
+#endif // Week02_PERFORMANCE_INCLUDE_LIFECYCLE_STATS_HPP_
@@ -1,45 +1,226 @@
 #ifndef Week02_PERFORMANCE_INCLUDE_MY_STRING_HPP_
 #define Week02_PERFORMANCE_INCLUDE_MY_STRING_HPP_
 
+#include <algorithm> // for std::max
+#include <functional> // for std::hash
 #include <iostream>
-#include <cstring> // for strlen, strcpy
+#include <cstring> // for strlen, memcpy
+#include <memory_resource> // for std::pmr::memory_resource
+
+#include "lifecycle_stats.hpp"
+#include "my_string_view.hpp"
+#include "string_concat.hpp"
+#include "string_simd.hpp"
 
 class MyString {
 public:
+  // SSO (Small String Optimization) 阈值：长度 <= 23 的字符串直接存放在对象内部的 local_buf_ 中，
+  // 不触碰堆分配器。23 + 1('\0') = 24 字节，覆盖了绝大多数 key / token。
+  static constexpr size_t kLocalCapacity = 23;
+
+  // 生命周期计数器 (构造/拷贝/移动/分配字节数)，Release 构建下编译为空
+  using Stats = LifecycleStats<MyString>;
+
+  // ------------------------- 内存来源 (std::pmr) -------------------------
+  // 长串的堆内存不再写死 new[] / delete[]，而是向构造时传入的 std::pmr::memory_resource 申请。
+  // 不传就是 std::pmr::get_default_resource() (默认即 new / delete)，行为和以前完全一样。
+  // 典型用法：处理一个请求期间的临时字符串都从一块 monotonic_buffer_resource 里切，请求结束整块释放：
+  //   std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+  //   MyString path("/api/v1/users/42/profile/settings", &arena);
+  //
+  // 与 std::pmr::string 的规则一致：
+  //   - resource 跟着对象走，赋值时不会换成对方的 resource
+  //   - 拷贝构造用默认 resource (副本可能比 arena 活得久)，要留在 arena 里就显式传 resource
+  //   - 移动构造连同 resource 一起偷走，O(1)
+  //   - 移动赋值：resource 相同时偷指针 O(1)；不同时只能在自己的 resource 里深拷贝
+
   // 1. 默认构造
-  // 目标：创建一个空字符串 "" (注意不是空指针，而是包含一个 \0 的数组)
+  // 目标：创建一个空字符串 ""。空串走 SSO，data_ 指向内部缓冲区，不再 new char[1]
   MyString();
+  explicit MyString(std::pmr::memory_resource* resource);
 
   // 2. 有参构造
-  // 目标：根据传入的 C 风格字符串，申请堆内存并复制内容
-  MyString(const char* str);
+  // 目标：根据传入的 C 风格字符串复制内容。短串放进 local_buf_，长串才向 resource 申请内存
+  MyString(const char* str, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  // 从视图深拷贝出一个拥有内存的字符串。加 explicit：分配内存的转换必须显式写出来
+  explicit MyString(MyStringView view,
+                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   // 3. 拷贝构造 (Deep Copy)
   // 目标：深拷贝。申请新内存，把 other 的内容复制过来。
-  // 要求：请打印 "Copy Constructor" 以便后续观察性能
+  // 计入 Stats 的 copies / bytes_copied，以便后续观察性能
   MyString(const MyString& other);
+  MyString(const MyString& other, std::pmr::memory_resource* resource);
 
   // 4. 拷贝赋值运算符 (Deep Copy)
   // 目标：深拷贝。注意处理"自赋值"和"旧内存清理"。
-  // 要求：请打印 "Copy Assignment" 以便后续观察性能
+  // 计入 Stats 的 copies / bytes_copied，以便后续观察性能
   MyString& operator=(const MyString& other);
 
   // 5. 析构
-  // 目标：释放堆内存
+  // 目标：释放堆内存 (SSO 状态下什么都不用做)
   ~MyString();
 
   // 6. 移动构造 (偷窃)
+  // 注意：短串没有可以"偷"的堆指针，只能把 local_buf_ 的内容复制过来 (最多 24 字节，依然 O(1))
+  // 堆内存连同它的 resource 一起接管，所以永远是 O(1) 且 noexcept (vector 扩容依赖这一点)
   MyString(MyString&& other) noexcept;
 
   // 7. Move Assignment Operator (偷窃 + 清理旧账) ———— 移动赋值
-  MyString& operator=(MyString&& other) noexcept;
+  // 没有 noexcept：两边 resource 不同时，对方的堆内存不能交给自己的 resource 释放，
+  // 只能在自己的 resource 里重新分配一份 (可能抛 bad_alloc)。std::pmr::string 也是同样的规定
+  MyString& operator=(MyString&& other);
+
+  // 8. 从拼接表达式物化 (见 string_concat.hpp)
+  // MyString s = a + b + "\n"; 只在这里分配一次恰好大小的内存
+  // 不加 explicit：要让 MyString s = a + b; 这种写法直接生效
+  template <typename L, typename R>
+  MyString(const ConcatExpr<L, R>& expr,
+           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  // ------------------------- 增量构建 -------------------------
+  // 容量按几何级数 (x2) 增长：连续 Append n 个字节，总的复制量是 O(n) 而不是 O(n^2)
+
+  // 预留至少 new_capacity 个字符的空间 (不含 \0)。只会变大，不会收缩
+  void Reserve(size_t new_capacity);
+
+  // 追加 len 个字节。str 允许指向自身 (例如 s.Append(s.data(), s.size()))
+  void Append(const char* str, size_t len);
+  void Append(const char* str);
+  void Append(const MyString& other);
+
+  // 追加一个字符
+  void PushBack(char ch);
+
+  MyString& operator+=(const MyString& other);
+  MyString& operator+=(const char* str);
+  MyString& operator+=(char ch);
+
+  // s += a + b：容量不够时也只分配一次
+  template <typename L, typename R>
+  MyString& operator+=(const ConcatExpr<L, R>& expr);
+
+  // 清空内容，但保留已申请的容量 (方便复用缓冲区)
+  void Clear();
+
+  // ------------------------- 访问器 -------------------------
+  size_t size() const { return length_; }
+  size_t capacity() const { return IsLocal() ? kLocalCapacity : capacity_; }
+  bool empty() const { return length_ == 0; }
+  const char* data() const { return data_; }
+  const char* c_str() const { return data_; }
+
+  // 长串内存的来源
+  std::pmr::memory_resource* resource() const { return resource_; }
+
+  // ------------------------- 视图 -------------------------
+  // 隐式转换成非拥有的视图 (只是 指针 + 长度，零拷贝)
+  operator MyStringView() const { return MyStringView(data_, length_); }
+
+  // 零拷贝子串：返回指向自身缓冲区的视图。
+  // 临时对象上调用会产生悬垂视图，所以对右值直接禁用：MyString("abc").Substr(1) 编译不过
+  MyStringView Substr(size_t pos, size_t count = kNotFound) const& {
+    return MyStringView(data_, length_).Substr(pos, count);
+  }
+  MyStringView Substr(size_t pos, size_t count = kNotFound) const&& = delete;
+
+  // ------------------------- 查找 / 比较 / 哈希 -------------------------
+  // 底层走 string_simd.hpp 的 SSE2/AVX2 内核 (运行时按 CPU 分派)，不再是逐字节循环。
+  // 参数是视图：MyString、C 字符串、MyStringView 都能直接传进来，不会产生临时 MyString
+
+  // 找不到时返回 kNpos
+  static constexpr size_t kNpos = kNotFound;
+
+  // 从 pos 开始查找字符 / 子串第一次出现的位置
+  size_t Find(char ch, size_t pos = 0) const;
+  size_t Find(MyStringView needle, size_t pos = 0) const;
+
+  // 字典序比较 (按无符号字节)，返回 <0 / 0 / >0
+  int Compare(MyStringView other) const;
+
+  // 64 位哈希 (CRC32C)，可以直接当 unordered_map 的 key (见文件末尾的 std::hash 特化)
+  size_t Hash() const;
+
+  friend bool operator==(const MyString& lhs, const MyString& rhs);
+  friend bool operator==(const MyString& lhs, const char* rhs);
 
   // 辅助打印函数
   void Print() const;
 
+  // 当前是否处于 SSO 状态 (数据存放在对象内部)
+  bool IsLocal() const { return data_ == local_buf_; }
+
 private:
-  char* data_;    // 原始指针，管理堆内存
+  // 按长度选择存储位置并复制 len 个字节，末尾补 '\0'
+  void InitFrom(const char* str, size_t len);
+
+  // 向 resource_ 申请能放下 capacity 个字符 (+1 个 \0) 的内存
+  char* Allocate(size_t capacity) const;
+
+  // 扩容到至少 min_capacity：新容量 = max(min_capacity, 2 * 当前容量)
+  void Grow(size_t min_capacity);
+
+  // 把堆内存 (如果有的话) 还给 resource_
+  void FreeHeap();
+
+  // 把自己重置为 SSO 空串 (移动之后的源对象就处于这个状态)
+  void ResetToEmpty();
+
+  char* data_;    // 指向 local_buf_ (短串) 或堆内存 (长串)
   size_t length_; // 字符串长度 (不含 \0)
+
+  // 短串时用 local_buf_ 存数据，长串时这块空间闲着，正好拿来存堆内存的容量。
+  // 两者不会同时使用，所以放进 union，对象大小不变。
+  union {
+    char local_buf_[kLocalCapacity + 1];  // SSO 内部缓冲区
+    size_t capacity_;                      // 堆内存容量 (不含 \0)，仅在 !IsLocal() 时有效
+  };
+
+  std::pmr::memory_resource* resource_;  // 堆内存从这里申请，也必须还到这里
+};
+
+// 表达式模板的叶子节点：只记录指针和长度，不复制数据
+inline StringPiece ToPiece(const MyString& str) { return StringPiece{str.data(), str.size()}; }
+inline StringPiece ToPiece(MyStringView view) { return StringPiece{view.data(), view.size()}; }
+
+template <typename L, typename R>
+MyString::MyString(const ConcatExpr<L, R>& expr, std::pmr::memory_resource* resource)
+    : MyString(resource) {
+  size_t len = expr.size();
+  Reserve(len);  // 短于 kLocalCapacity 时什么都不做，直接写进 local_buf_
+  expr.CopyTo(data_);
+  length_ = len;
+  data_[length_] = '\0';
+  Stats::OnBytesCopied(len);
+}
+
+template <typename L, typename R>
+MyString& MyString::operator+=(const ConcatExpr<L, R>& expr) {
+  size_t len = expr.size();
+  size_t new_length = length_ + len;
+  if (new_length <= capacity()) {
+    // 原地追加：即使表达式引用了自己，读 [0, length_) 写 [length_, new_length) 也不重叠
+    expr.CopyTo(data_ + length_);
+  } else {
+    // 扩容：表达式可能引用了自己的旧缓冲区 (s += s + "x")，
+    // 所以先在新缓冲区里拼好，最后再换掉旧的 (同一个 resource，最后的移动赋值只是换指针)
+    MyString grown(resource_);
+    grown.Reserve(std::max(new_length, 2 * capacity()));
+    std::memcpy(grown.data_, data_, length_);
+    expr.CopyTo(grown.data_ + length_);
+    *this = std::move(grown);
+  }
+  length_ = new_length;
+  data_[length_] = '\0';
+  Stats::OnBytesCopied(len);
+  return *this;
+}
+
+// 让 MyString 可以直接作为 std::unordered_map / std::unordered_set 的 key
+template <>
+struct std::hash<MyString> {
+  size_t operator()(const MyString& str) const noexcept { return str.Hash(); }
 };
 
 #endif // Week02_PERFORMANCE_INCLUDE_MY_STRING_HPP_
\ No newline at end of file
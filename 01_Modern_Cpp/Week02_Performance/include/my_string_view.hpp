@@ -0,0 +1,233 @@
+#ifndef Week02_PERFORMANCE_INCLUDE_MY_STRING_VIEW_HPP_
+#define Week02_PERFORMANCE_INCLUDE_MY_STRING_VIEW_HPP_
+
+#include <functional> // for std::hash
+#include <iostream>
+#include <iterator>
+#include <string> // for std::char_traits
+#include <type_traits>
+
+#include "string_simd.hpp"
+
+// 非拥有 (non-owning) 的字符串视图：只有 指针 + 长度 两个字段，拷贝就是复制 16 个字节。
+//
+// 它不管理内存，也不保证以 '\0' 结尾。Substr / Split / Trim 都只是移动指针、改长度，永远不分配内存，
+// 所以把一行请求 "GET /index.html HTTP/1.1" 切成 3 个 token 是零次分配 (以前每个 token 都要深拷贝成一个 MyString)。
+//
+// 代价是生命周期：视图必须比它指向的字符串先死。
+//   MyStringView v = some_string;            // OK：some_string 还活着
+//   MyStringView v = MyString("temporary");  // 危险！临时对象在这一行结束就析构了
+class MyStringView {
+public:
+  static constexpr size_t kNpos = kNotFound;
+
+  // ------------------------- 构造 -------------------------
+  constexpr MyStringView() : data_(""), length_(0) {}
+  constexpr MyStringView(const char* data, size_t length) : data_(data), length_(length) {}
+
+  // 不加 explicit：让 "abc" 可以直接传给接收 MyStringView 的函数 (同 std::string_view)
+  // char_traits::length 是 constexpr 的 strlen，字面量在编译期就能算出长度
+  constexpr MyStringView(const char* str)
+      : data_(str == nullptr ? "" : str),
+        length_(str == nullptr ? 0 : std::char_traits<char>::length(str)) {}
+
+  // ------------------------- 访问器 -------------------------
+  constexpr size_t size() const { return length_; }
+  constexpr bool empty() const { return length_ == 0; }
+  constexpr const char* data() const { return data_; }
+  constexpr const char* begin() const { return data_; }
+  constexpr const char* end() const { return data_ + length_; }
+  constexpr char operator[](size_t i) const { return data_[i]; }
+
+  // ------------------------- 零拷贝切片 -------------------------
+  // 从 pos 开始取 count 个字符。pos 越界时返回空视图，count 超出时截到末尾
+  constexpr MyStringView Substr(size_t pos, size_t count = kNpos) const {
+    if (pos > length_) {
+      return MyStringView(data_ + length_, 0);
+    }
+    size_t rest = length_ - pos;
+    return MyStringView(data_ + pos, count < rest ? count : rest);
+  }
+
+  // 去掉首尾的空白字符 (空格、\t、\r、\n、\v、\f)
+  constexpr MyStringView TrimLeft() const {
+    size_t begin = 0;
+    while (begin < length_ && IsSpace(data_[begin])) ++begin;
+    return MyStringView(data_ + begin, length_ - begin);
+  }
+
+  constexpr MyStringView TrimRight() const {
+    size_t end = length_;
+    while (end > 0 && IsSpace(data_[end - 1])) --end;
+    return MyStringView(data_, end);
+  }
+
+  constexpr MyStringView Trim() const { return TrimLeft().TrimRight(); }
+
+  constexpr bool StartsWith(MyStringView prefix) const {
+    return prefix.length_ <= length_ && Substr(0, prefix.length_) == prefix;
+  }
+
+  constexpr bool EndsWith(MyStringView suffix) const {
+    return suffix.length_ <= length_ && Substr(length_ - suffix.length_) == suffix;
+  }
+
+  // ------------------------- 查找 / 比较 / 哈希 (SIMD 内核) -------------------------
+  size_t Find(char ch, size_t pos = 0) const {
+    if (pos >= length_) {
+      return kNpos;
+    }
+    size_t found = ActiveKernels().find_char(data_ + pos, length_ - pos, ch);
+    return found == kNotFound ? kNpos : pos + found;
+  }
+
+  size_t Find(MyStringView needle, size_t pos = 0) const {
+    if (pos > length_) {
+      return kNpos;
+    }
+    size_t found = ActiveKernels().find(data_ + pos, length_ - pos, needle.data_, needle.length_);
+    return found == kNotFound ? kNpos : pos + found;
+  }
+
+  // 字典序比较 (按无符号字节)，返回 <0 / 0 / >0
+  int Compare(MyStringView other) const {
+    size_t common = length_ < other.length_ ? length_ : other.length_;
+    int result = ActiveKernels().compare(data_, other.data_, common);
+    if (result != 0) {
+      return result;
+    }
+    return length_ < other.length_ ? -1 : (length_ > other.length_ ? 1 : 0);
+  }
+
+  // 与 MyString::Hash 完全相同 (同一个 CRC32C 内核)，视图和拥有它的字符串哈希值一致。
+  // constexpr：编译期走 ConstexprHash，结果与运行期的 SIMD 内核相同，可以用作 case 标签
+  constexpr size_t Hash() const {
+    if (std::is_constant_evaluated()) {
+      return static_cast<size_t>(ConstexprHash(data_, length_));
+    }
+    return static_cast<size_t>(ActiveKernels().hash(data_, length_));
+  }
+
+  // constexpr 版本：编译期逐字节比较，运行期走 SIMD 内核
+  friend constexpr bool operator==(MyStringView lhs, MyStringView rhs) {
+    if (lhs.length_ != rhs.length_) {
+      return false;
+    }
+    if (std::is_constant_evaluated()) {
+      for (size_t i = 0; i < lhs.length_; ++i) {
+        if (lhs.data_[i] != rhs.data_[i]) return false;
+      }
+      return true;
+    }
+    return ActiveKernels().compare(lhs.data_, rhs.data_, lhs.length_) == 0;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, MyStringView view) {
+    return os.write(view.data_, static_cast<std::streamsize>(view.length_));
+  }
+
+  // ------------------------- 按分隔符切分 -------------------------
+  // for (MyStringView token : line.Split(' ')) { ... }
+  // 惰性切分：迭代器每次前进只 Find 下一个分隔符，不产生 vector，也不分配内存。
+  // 与 Python 的 str.split(sep) 一致：相邻的分隔符之间会产生空 token，"a,,b" -> "a", "", "b"
+  class SplitRange;
+  SplitRange Split(char delim) const;
+
+private:
+  static constexpr bool IsSpace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\v' || ch == '\f';
+  }
+
+  const char* data_;
+  size_t length_;
+};
+
+class MyStringView::SplitRange {
+public:
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = MyStringView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const MyStringView*;
+    using reference = const MyStringView&;
+
+    Iterator() = default;
+
+    reference operator*() const { return token_; }
+    pointer operator->() const { return &token_; }
+
+    Iterator& operator++() {
+      if (last_) {
+        done_ = true;
+        return *this;
+      }
+      Advance(rest_);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      if (lhs.done_ || rhs.done_) {
+        return lhs.done_ == rhs.done_;
+      }
+      return lhs.token_.data() == rhs.token_.data() && lhs.token_.size() == rhs.token_.size();
+    }
+
+  private:
+    friend class SplitRange;
+
+    Iterator(MyStringView text, char delim) : delim_(delim), done_(false) { Advance(text); }
+
+    // 从 text 里切出下一个 token：找到分隔符就切开，找不到说明这是最后一个 token
+    void Advance(MyStringView text) {
+      size_t pos = text.Find(delim_);
+      if (pos == kNpos) {
+        token_ = text;
+        rest_ = MyStringView(text.end(), 0);
+        last_ = true;
+      } else {
+        token_ = text.Substr(0, pos);
+        rest_ = text.Substr(pos + 1);
+      }
+    }
+
+    MyStringView token_;
+    MyStringView rest_;
+    char delim_ = ' ';
+    bool last_ = false;
+    bool done_ = true;  // 默认构造的迭代器就是 end()
+  };
+
+  Iterator begin() const { return Iterator(text_, delim_); }
+
+  Iterator end() const { return Iterator(); }
+
+private:
+  friend class MyStringView;
+
+  SplitRange(MyStringView text, char delim) : text_(text), delim_(delim) {}
+
+  MyStringView text_;
+  char delim_;
+};
+
+inline MyStringView::SplitRange MyStringView::Split(char delim) const {
+  return SplitRange(*this, delim);
+}
+
+// 视图必须能像原生指针一样随便按值传递
+static_assert(std::is_trivially_copyable_v<MyStringView>);
+static_assert(sizeof(MyStringView) == 2 * sizeof(void*));
+
+template <>
+struct std::hash<MyStringView> {
+  size_t operator()(MyStringView view) const noexcept { return view.Hash(); }
+};
+
+#endif // Week02_PERFORMANCE_INCLUDE_MY_STRING_VIEW_HPP_
@@ -0,0 +1,98 @@
+#ifndef Week02_PERFORMANCE_INCLUDE_STRING_CONCAT_HPP_
+#define Week02_PERFORMANCE_INCLUDE_STRING_CONCAT_HPP_
+
+#include <concepts>
+#include <cstring> // for strlen, memcpy
+
+// 表达式模板 (Expression Templates)：惰性拼接
+//
+// 朴素写法 a + b + c + d 会产生 3 个临时 MyString，每个 + 一次分配 + 一次复制。
+// 这里的 operator+ 不做任何拼接，只是把操作数"记下来"，返回一棵轻量的表达式树：
+//
+//   a + b + c  ==>  ConcatExpr<ConcatExpr<StringPiece, StringPiece>, StringPiece>
+//
+// 直到赋给 MyString 时才"物化"(materialize)：先 size() 算出总长度，一次性申请恰好大小的内存，
+// 再 CopyTo() 把每一段 memcpy 过去。整条链只有 1 次分配。
+//
+// 注意生命周期：表达式树里存的是 指针 + 长度 (不拷贝数据)，所以被引用的字符串必须活到物化那一刻。
+//   MyString s = a + b + "\n";        // OK：同一个完整表达式里就物化了
+//   auto e = a + b;                   // OK：只要 a、b 还活着
+//   auto e = MyString("tmp") + a;     // 危险！临时对象在这一行结束就析构了，e 里是悬垂指针
+
+class MyString;
+class MyStringView;
+
+// 叶子节点 1：一段连续的字符 (来自 MyString 或 C 字符串)
+struct StringPiece {
+  const char* data;
+  size_t length;
+
+  size_t size() const { return length; }
+
+  char* CopyTo(char* dest) const {
+    std::memcpy(dest, data, length);
+    return dest + length;
+  }
+};
+
+// 叶子节点 2：单个字符
+struct CharPiece {
+  char ch;
+
+  size_t size() const { return 1; }
+
+  char* CopyTo(char* dest) const {
+    *dest = ch;
+    return dest + 1;
+  }
+};
+
+// 内部节点：左右两棵子树。按值存储 (叶子只是指针 + 长度，整棵树也就几十个字节)
+template <typename L, typename R>
+class ConcatExpr {
+public:
+  ConcatExpr(L lhs, R rhs) : lhs_(lhs), rhs_(rhs) {}
+
+  // 拼接后的总长度
+  size_t size() const { return lhs_.size() + rhs_.size(); }
+
+  // 按从左到右的顺序把所有片段写到 dest，返回写完之后的位置 (不写 \0)
+  char* CopyTo(char* dest) const { return rhs_.CopyTo(lhs_.CopyTo(dest)); }
+
+private:
+  L lhs_;
+  R rhs_;
+};
+
+template <typename T>
+inline constexpr bool kIsConcatExpr = false;
+
+template <typename L, typename R>
+inline constexpr bool kIsConcatExpr<ConcatExpr<L, R>> = true;
+
+// 能"驱动"表达式模板的类型：MyString / MyStringView 本身，或者已经是一棵表达式树
+template <typename T>
+concept StringExpr = std::same_as<T, MyString> || std::same_as<T, MyStringView> || kIsConcatExpr<T>;
+
+// 能参与拼接的类型：再加上 C 字符串 (含字符串字面量) 和单个字符
+template <typename T>
+concept ConcatOperand =
+    StringExpr<T> || std::convertible_to<const T&, const char*> || std::same_as<T, char>;
+
+// 把操作数转换成表达式树的节点。MyString / MyStringView 的重载在 my_string.hpp 里 (通过 ADL 找到)
+inline StringPiece ToPiece(const char* str) { return StringPiece{str, std::strlen(str)}; }
+inline CharPiece ToPiece(char ch) { return CharPiece{ch}; }
+
+template <typename L, typename R>
+const ConcatExpr<L, R>& ToPiece(const ConcatExpr<L, R>& expr) {
+  return expr;
+}
+
+// 至少一侧是 MyString / 表达式树时才启用，避免劫持 "abc" + 'x' 这类内置的指针运算
+template <typename L, typename R>
+  requires ConcatOperand<L> && ConcatOperand<R> && (StringExpr<L> || StringExpr<R>)
+auto operator+(const L& lhs, const R& rhs) {
+  return ConcatExpr(ToPiece(lhs), ToPiece(rhs));
+}
+
+#endif // Week02_PERFORMANCE_INCLUDE_STRING_CONCAT_HPP_
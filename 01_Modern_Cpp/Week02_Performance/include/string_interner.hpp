@@ -0,0 +1,116 @@
+#ifndef Week02_PERFORMANCE_INCLUDE_STRING_INTERNER_HPP_
+#define Week02_PERFORMANCE_INCLUDE_STRING_INTERNER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional> // for std::hash
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "my_string.hpp"
+
+// 字符串驻留 (String Interning)
+//
+// 流量里反复出现的只有几千个不同的方法名 / 头部名，却要被比较、哈希上百万次。
+// 驻留池给每个不同的字符串只存一份，返回一个指向这份唯一副本的句柄 InternedString：
+//   - 相等比较：比较两个指针 (同一个池里，内容相同 <=> 指针相同)
+//   - 哈希：直接返回入池时算好的值
+//   - Id()：入池顺序分配的稠密整数，可以直接当数组下标
+//
+// 并发：池被切成多个分片 (shard)，按哈希值选分片，每个分片一把读写锁。
+// 绝大多数请求是"已经在池里了"，只需要拿分片的读锁，多个线程可以同时查找；
+// 只有第一次出现的新字符串才需要写锁。
+
+class StringInterner;
+
+// 驻留字符串的句柄：只有一个指针，按值传递
+class InternedString {
+public:
+  // 默认句柄表示空串 ""。空串不入池，Intern("") 也返回默认句柄，保证两者相等
+  InternedString() = default;
+
+  MyStringView View() const { return entry_ ? MyStringView(entry_->str) : MyStringView(); }
+  size_t Hash() const { return entry_ ? entry_->hash : MyStringView().Hash(); }
+
+  // 入池顺序编号 (从 1 开始，空串为 0)
+  uint32_t Id() const { return entry_ ? entry_->id : 0; }
+
+  bool empty() const { return entry_ == nullptr; }
+
+  // 只比较指针。只对同一个池里出来的句柄有意义
+  friend bool operator==(InternedString lhs, InternedString rhs) { return lhs.entry_ == rhs.entry_; }
+
+  friend std::ostream& operator<<(std::ostream& os, InternedString str) { return os << str.View(); }
+
+private:
+  friend class StringInterner;
+
+  // 池里的唯一副本，地址在池的生命周期内保持不变
+  struct Entry {
+    MyString str;
+    size_t hash;
+    uint32_t id;
+  };
+
+  explicit InternedString(const Entry* entry) : entry_(entry) {}
+
+  const Entry* entry_ = nullptr;
+};
+
+class StringInterner {
+public:
+  // shard_count 会被向上取整到 2 的幂。分片越多，多线程插入新字符串时的锁冲突越少
+  explicit StringInterner(size_t shard_count = 64);
+
+  // 池持有所有句柄指向的内存，不允许拷贝 / 移动
+  StringInterner(const StringInterner&) = delete;
+  StringInterner& operator=(const StringInterner&) = delete;
+
+  // 查找或插入。返回的句柄在池析构之前一直有效
+  InternedString Intern(MyStringView str);
+
+  // 只查找，不插入。不在池里时返回 false
+  bool Find(MyStringView str, InternedString* out) const;
+
+  // 池里不同字符串的个数 (不含空串)
+  size_t size() const { return next_id_.load(std::memory_order_relaxed) - 1; }
+
+private:
+  using Entry = InternedString::Entry;
+
+  // 哈希表的 key：视图指向 Entry 里的字符串，哈希值只算一次
+  struct Key {
+    MyStringView view;
+    size_t hash;
+
+    friend bool operator==(const Key& lhs, const Key& rhs) {
+      return lhs.hash == rhs.hash && lhs.view == rhs.view;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  // 每个分片独占 cache line，避免相邻分片的锁互相 false sharing
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<Key, const Entry*, KeyHash> index;
+    std::deque<Entry> storage;  // deque 尾部插入不会移动已有元素，Entry 地址稳定
+  };
+
+  Shard& ShardFor(size_t hash) const { return shards_[(hash >> 32) & shard_mask_]; }
+
+  std::unique_ptr<Shard[]> shards_;
+  size_t shard_mask_;
+  std::atomic<uint32_t> next_id_{1};
+};
+
+template <>
+struct std::hash<InternedString> {
+  size_t operator()(InternedString str) const noexcept { return str.Hash(); }
+};
+
+#endif // Week02_PERFORMANCE_INCLUDE_STRING_INTERNER_HPP_
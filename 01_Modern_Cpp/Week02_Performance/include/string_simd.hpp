@@ -0,0 +1,82 @@
+#ifndef Week02_PERFORMANCE_INCLUDE_STRING_SIMD_HPP_
+#define Week02_PERFORMANCE_INCLUDE_STRING_SIMD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+// 字符串内核 (查找 / 比较 / 哈希) 的 SIMD 实现 + 运行时 CPU 分派。
+//
+// 同一个二进制里同时编译了三套实现 (用 __attribute__((target(...))) 按函数开启指令集，不需要改编译选项)：
+//   - kScalar：逐字节循环，任何平台都能跑
+//   - kSse2  ：一次处理 16 字节 (x86-64 的基线指令集，一定存在)
+//   - kAvx2  ：一次处理 32 字节
+// 程序启动后第一次调用时用 __builtin_cpu_supports 探测 CPU，选出最高可用级别；
+// 测试时可以用 SetSimdLevel 强制降级，这样任何 x86-64 机器都能把每条路径都跑一遍。
+//
+// 哈希用的是 CRC32C：AVX2 路径用硬件 crc32 指令 (AVX2 CPU 必然支持 SSE4.2)，其余路径用查表法。
+// 各路径结果完全一致，切换级别不会让已经算好的哈希失效。
+
+enum class SimdLevel { kScalar, kSse2, kAvx2 };
+
+// 一套内核的函数指针表
+struct StringKernels {
+  // 在 [data, data + len) 中查找字符 ch，返回下标；找不到返回 kNotFound
+  size_t (*find_char)(const char* data, size_t len, char ch);
+
+  // 在 haystack 中查找 needle 第一次出现的位置；找不到返回 kNotFound。空 needle 返回 0
+  size_t (*find)(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len);
+
+  // 按无符号字节比较前 len 个字节，语义同 memcmp (<0 / 0 / >0)
+  int (*compare)(const char* lhs, const char* rhs, size_t len);
+
+  // CRC32C 哈希 (混合了长度，扩展到 64 位)
+  uint64_t (*hash)(const char* data, size_t len);
+};
+
+inline constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+// 当前 CPU 支持的最高级别
+SimdLevel DetectSimdLevel();
+
+// 当前正在使用的级别
+SimdLevel ActiveSimdLevel();
+
+// 强制使用某个级别 (测试 / benchmark 用)。超过 CPU 能力的请求会被降到 DetectSimdLevel()
+void SetSimdLevel(SimdLevel level);
+
+const char* SimdLevelName(SimdLevel level);
+
+// 某个级别对应的内核表 (不经过分派，benchmark 可以直接对比)
+const StringKernels& KernelsFor(SimdLevel level);
+
+// 当前级别的内核表
+const StringKernels& ActiveKernels();
+
+// ------------------------- 编译期哈希 -------------------------
+// 与 StringKernels::hash 完全相同的算法 (CRC32C + fmix64)，但写成 constexpr：
+// 逐位计算，不需要查表，也不需要 CPU 指令。编译期算出的常量可以直接和运行期的哈希值比较，
+// 例如 switch (view.Hash()) { case FixedString("GET").Hash(): ... }
+
+// 把 32 位的 CRC 和长度混合成 64 位哈希 (MurmurHash3 的 fmix64)
+constexpr uint64_t MixCrcHash(uint32_t crc, size_t len) {
+  uint64_t h = (static_cast<uint64_t>(crc) << 32) ^ static_cast<uint64_t>(len);
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+constexpr uint64_t ConstexprHash(const char* data, size_t len) {
+  uint32_t crc = ~0u;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= static_cast<unsigned char>(data[i]);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+    }
+  }
+  return MixCrcHash(~crc, len);
+}
+
+#endif // Week02_PERFORMANCE_INCLUDE_STRING_SIMD_HPP_
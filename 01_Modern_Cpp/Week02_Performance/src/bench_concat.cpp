@@ -0,0 +1,89 @@
+// src/bench_concat.cpp
+// 拼接性能对比：朴素拼接 (每个 + 一个临时对象) vs 表达式模板 vs std::string
+// 场景模拟 Week05 的 echo 回包："Server Echo: " + msg + "\n"
+//
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+// (Debug 构建下 LifecycleStats 开启，会额外打印每次操作的堆分配次数)
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "my_string.hpp"
+
+const int kIterations = 1000000;
+
+// 朴素拼接：模拟没有表达式模板时 a + b 的行为 —— 每次都产生一个新的 MyString
+MyString NaiveConcat(const MyString& lhs, const MyString& rhs) {
+  MyString result(lhs);
+  result.Append(rhs);
+  return result;
+}
+
+// 跑 kIterations 次 fn，打印平均每次的耗时。返回值累加进 sink，防止被编译器优化掉
+template <typename Fn>
+void Run(const char* name, Fn fn) {
+  size_t sink = 0;
+  uint64_t allocs_before = MyString::Stats::Get().heap_allocations;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i) {
+    sink += fn();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+  std::cout << "  " << name << ": " << ns << " ns/op";
+  if constexpr (MyString::Stats::kEnabled) {
+    uint64_t allocs = MyString::Stats::Get().heap_allocations - allocs_before;
+    std::cout << ", MyString heap allocs/op = " << static_cast<double>(allocs) / kIterations;
+  }
+  std::cout << "  (sink=" << sink << ")" << std::endl;
+}
+
+void Bench(const char* label, const char* payload) {
+  std::cout << "--- " << label << " ---" << std::endl;
+
+  MyString prefix("Server Echo: ");
+  MyString msg(payload);
+  MyString newline("\n");
+  std::string std_msg(payload);
+
+  Run("naive MyString (a + b + c)", [&] {
+    MyString reply = NaiveConcat(NaiveConcat(prefix, msg), newline);
+    return reply.size();
+  });
+
+  Run("expression template       ", [&] {
+    MyString reply = prefix + msg + "\n";
+    return reply.size();
+  });
+
+  Run("std::string               ", [&] {
+    std::string reply = "Server Echo: " + std_msg + "\n";
+    return reply.size();
+  });
+
+  // 4 段以上的链条，差距会随段数线性拉大
+  Run("naive MyString, 5 pieces  ", [&] {
+    MyString reply = NaiveConcat(NaiveConcat(NaiveConcat(NaiveConcat(prefix, msg), prefix), msg),
+                                 newline);
+    return reply.size();
+  });
+
+  Run("expr template, 5 pieces   ", [&] {
+    MyString reply = prefix + msg + prefix + msg + "\n";
+    return reply.size();
+  });
+
+  Run("std::string, 5 pieces     ", [&] {
+    std::string reply = "Server Echo: " + std_msg + "Server Echo: " + std_msg + "\n";
+    return reply.size();
+  });
+}
+
+int main() {
+  std::cout << "=== Concatenation Benchmark (" << kIterations << " iterations) ===" << std::endl;
+  Bench("short message (fits SSO)", "ping");
+  Bench("long message (heap)", "GET /api/v1/users?id=42 HTTP/1.1 keep-alive please");
+  return 0;
+}
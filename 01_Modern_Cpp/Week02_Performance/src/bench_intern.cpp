@@ -0,0 +1,125 @@
+// src/bench_intern.cpp
+// 驻留字符串 vs 普通 MyString 作为哈希表 key 的性能对比，以及分片锁下多线程 Intern 的吞吐
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "string_interner.hpp"
+
+const int kDistinctKeys = 2000;
+const int kLookups = 5000000;
+
+// 跑 fn，打印平均每次操作的耗时
+template <typename Fn>
+void Run(const char* name, int ops, Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  size_t sink = fn();
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / ops;
+  std::cout << "  " << name << ": " << ns << " ns/op  (sink=" << sink << ")" << std::endl;
+}
+
+// 生成形如 "X-Custom-Header-Name-0042" 的头部名 (> 23 字节，走堆内存，哈希和比较都不是白给的)
+std::vector<MyString> MakeKeys() {
+  std::vector<MyString> keys;
+  for (int i = 0; i < kDistinctKeys; ++i) {
+    std::string name = "X-Custom-Header-Name-" + std::to_string(10000 + i);
+    keys.emplace_back(name.c_str());
+  }
+  return keys;
+}
+
+void BenchLookup(const std::vector<MyString>& keys, StringInterner& interner) {
+  std::cout << "--- hash map lookup, " << kDistinctKeys << " distinct keys ---" << std::endl;
+
+  // 访问序列：模拟解析出来的请求头，随机重复
+  std::mt19937 rng(7);
+  std::vector<int> order(kLookups);
+  for (int& i : order) i = static_cast<int>(rng() % kDistinctKeys);
+
+  std::unordered_map<MyString, int> plain_map;
+  std::unordered_map<InternedString, int> interned_map;
+  std::vector<InternedString> handles;
+  for (int i = 0; i < kDistinctKeys; ++i) {
+    plain_map[keys[i]] = i;
+    handles.push_back(interner.Intern(keys[i]));
+    interned_map[handles.back()] = i;
+  }
+
+  Run("unordered_map<MyString>      ", kLookups, [&] {
+    size_t sum = 0;
+    for (int i : order) sum += plain_map.find(keys[i])->second;  // 每次都要算哈希 + 比较内容
+    return sum;
+  });
+
+  Run("unordered_map<InternedString>", kLookups, [&] {
+    size_t sum = 0;
+    for (int i : order) sum += interned_map.find(handles[i])->second;  // 哈希是现成的，比较是指针
+    return sum;
+  });
+
+  Run("dense array by Id()          ", kLookups, [&] {
+    std::vector<int> table(interner.size() + 1);
+    for (int i = 0; i < kDistinctKeys; ++i) table[handles[i].Id()] = i;
+    size_t sum = 0;
+    for (int i : order) sum += table[handles[i].Id()];  // 连哈希表都不需要
+    return sum;
+  });
+
+  std::cout << "--- equality, " << kLookups << " comparisons of equal-length keys ---" << std::endl;
+  Run("MyString ==                  ", kLookups, [&] {
+    size_t equal = 0;
+    for (int i = 1; i < kLookups; ++i) equal += keys[order[i]] == keys[order[i - 1]];
+    return equal;
+  });
+  Run("InternedString ==            ", kLookups, [&] {
+    size_t equal = 0;
+    for (int i = 1; i < kLookups; ++i) equal += handles[order[i]] == handles[order[i - 1]];
+    return equal;
+  });
+}
+
+// 多个线程同时 Intern (绝大多数命中已有字符串)，对比 1 个分片 (等价于一把全局锁) 和 64 个分片
+void BenchConcurrentIntern(const std::vector<MyString>& keys, size_t shards, int num_threads) {
+  StringInterner interner(shards);
+  const int kPerThread = 1000000;
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t] {
+      std::mt19937 rng(t);
+      for (int i = 0; i < kPerThread; ++i) {
+        interner.Intern(keys[rng() % kDistinctKeys]);
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "  shards=" << shards << " threads=" << num_threads << ": "
+            << num_threads * kPerThread / seconds / 1e6 << " M interns/s"
+            << "  (distinct=" << interner.size() << ")" << std::endl;
+}
+
+int main() {
+  std::vector<MyString> keys = MakeKeys();
+  StringInterner interner;
+
+  std::cout << "=== String Interning Benchmark ===" << std::endl;
+  BenchLookup(keys, interner);
+
+  std::cout << "--- concurrent Intern (hardware threads: " << std::thread::hardware_concurrency()
+            << ") ---" << std::endl;
+  for (int threads : {1, 4, 8}) {
+    BenchConcurrentIntern(keys, 1, threads);
+    BenchConcurrentIntern(keys, 64, threads);
+  }
+  return 0;
+}
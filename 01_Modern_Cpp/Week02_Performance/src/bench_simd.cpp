@@ -0,0 +1,118 @@
+// src/bench_simd.cpp
+// 查找 / 比较 / 哈希的微基准：每个 SIMD 级别 vs memchr / memcmp / std::string / std::hash
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "my_string.hpp"
+
+// 跑 iterations 次 fn，打印每次的耗时和吞吐 (GB/s)。返回值累加进 sink，防止被编译器优化掉
+template <typename Fn>
+void Run(const std::string& name, size_t bytes_per_op, int iterations, Fn fn) {
+  size_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    // 编译器屏障：告诉编译器"内存可能变了"，否则 memchr / memcmp 这类纯函数会被提到循环外只算一次
+    asm volatile("" ::: "memory");
+    sink += fn();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  std::cout << "  " << name << ": " << ns << " ns/op, " << bytes_per_op / ns << " GB/s"
+            << "  (sink=" << sink % 10 << ")" << std::endl;
+}
+
+template <typename Fn>
+void ForEachLevel(Fn fn) {
+  for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse2, SimdLevel::kAvx2}) {
+    if (static_cast<int>(level) <= static_cast<int>(DetectSimdLevel())) {
+      fn(level);
+    }
+  }
+}
+
+std::string Pad(const char* name) {
+  std::string s(name);
+  s.resize(12, ' ');
+  return s;
+}
+
+void BenchFindChar(size_t len, int iterations) {
+  std::cout << "--- find char, " << len << " bytes, hit at the end ---" << std::endl;
+  std::string buf(len, 'a');
+  buf.back() = '\n';  // 模拟在请求缓冲区里找分隔符
+
+  ForEachLevel([&](SimdLevel level) {
+    const StringKernels& k = KernelsFor(level);
+    Run(Pad(SimdLevelName(level)), len, iterations, [&] { return k.find_char(buf.data(), len, '\n'); });
+  });
+  Run(Pad("memchr"), len, iterations, [&] {
+    return static_cast<size_t>(static_cast<const char*>(std::memchr(buf.data(), '\n', len)) - buf.data());
+  });
+  Run(Pad("std::string"), len, iterations, [&] { return buf.find('\n'); });
+}
+
+void BenchFind(size_t len, int iterations) {
+  std::cout << "--- find substring \"\\r\\n\\r\\n\", " << len << " bytes ---" << std::endl;
+  // 头部里大量单个 \r\n，只有结尾才是 \r\n\r\n：首尾字符过滤会遇到很多候选
+  std::string buf;
+  while (buf.size() + 32 < len) buf += "X-Header-Name: some value\r\n";
+  buf.resize(len - 4, 'a');
+  buf += "\r\n\r\n";
+
+  ForEachLevel([&](SimdLevel level) {
+    const StringKernels& k = KernelsFor(level);
+    Run(Pad(SimdLevelName(level)), len, iterations,
+        [&] { return k.find(buf.data(), len, "\r\n\r\n", 4); });
+  });
+  Run(Pad("memmem"), len, iterations, [&] {
+    return static_cast<size_t>(static_cast<const char*>(memmem(buf.data(), len, "\r\n\r\n", 4)) -
+                               buf.data());
+  });
+  Run(Pad("std::string"), len, iterations, [&] { return buf.find("\r\n\r\n"); });
+}
+
+void BenchCompare(size_t len, int iterations) {
+  std::cout << "--- compare equal strings, " << len << " bytes ---" << std::endl;
+  std::string a(len, 'k');
+  std::string b(len, 'k');
+
+  ForEachLevel([&](SimdLevel level) {
+    const StringKernels& k = KernelsFor(level);
+    Run(Pad(SimdLevelName(level)), len, iterations,
+        [&] { return static_cast<size_t>(k.compare(a.data(), b.data(), len) == 0); });
+  });
+  Run(Pad("memcmp"), len, iterations,
+      [&] { return static_cast<size_t>(std::memcmp(a.data(), b.data(), len) == 0); });
+  Run(Pad("std::string"), len, iterations, [&] { return static_cast<size_t>(a == b); });
+}
+
+void BenchHash(size_t len, int iterations) {
+  std::cout << "--- hash, " << len << " bytes ---" << std::endl;
+  std::string key(len, 'h');
+
+  ForEachLevel([&](SimdLevel level) {
+    const StringKernels& k = KernelsFor(level);
+    Run(Pad(SimdLevelName(level)), len, iterations, [&] { return k.hash(key.data(), len); });
+  });
+  Run(Pad("std::hash"), len, iterations, [&] { return std::hash<std::string_view>{}(key); });
+}
+
+int main() {
+  std::cout << "=== String Kernel Benchmark (CPU: " << SimdLevelName(DetectSimdLevel())
+            << ") ===" << std::endl;
+
+  BenchFindChar(16, 20000000);
+  BenchFindChar(4096, 200000);
+  BenchFind(4096, 200000);
+  BenchCompare(24, 20000000);
+  BenchCompare(4096, 200000);
+  BenchHash(16, 20000000);
+  BenchHash(4096, 200000);
+  return 0;
+}
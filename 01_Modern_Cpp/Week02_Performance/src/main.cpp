@@ -1,51 +1,200 @@
 // src/main.cpp
 #include <iostream>
+#include <memory_resource>
 #include <vector>
+#include <cstring>
 
+#include "fixed_string.hpp"
 #include "my_string.hpp"
 
+// 数一数向上游申请了几次内存。和 MyString::Stats 不同，它不受 LIFECYCLE_STATS 控制，Release 构建下一样准
+class CountingResource : public std::pmr::memory_resource {
+public:
+  explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : upstream_(upstream) {}
+
+  uint64_t allocations() const { return allocations_; }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations_;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    upstream_->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  std::pmr::memory_resource* upstream_;
+  uint64_t allocations_ = 0;
+};
+
+// 把 count 个 payload 推入 vector，返回这期间 MyString 向 resource 申请内存的次数
+uint64_t PushAndCountAllocs(const char* payload, int count, CountingResource& resource) {
+  uint64_t before = resource.allocations();
+  std::vector<MyString> vec;
+  for (int i = 0; i < count; ++i) {
+    MyString temp(payload, &resource);
+    vec.push_back(std::move(temp));
+  }
+  return resource.allocations() - before;
+}
+
+// 协议命令：命令名是模板参数 (NTTP)，哈希在编译期就算好了，运行期不分配、不再算一遍
+template <FixedString kName>
+struct Command {
+  static constexpr size_t kHash = kName.Hash();
+  static bool Matches(MyStringView token) { return token == kName; }
+};
+
+using GetCommand = Command<"GET">;
+using SetCommand = Command<"SET">;
+using DelCommand = Command<"DEL">;
+using PingCommand = Command<"PING">;
+
+// switch 分派：运行期只对 token 算一次哈希，然后是跳转表。
+// 哈希相同还要再比较一次内容 (防碰撞)；两个命令的哈希如果撞了，case 重复会直接编译失败
+const char* Dispatch(MyStringView token) {
+  switch (token.Hash()) {
+    case GetCommand::kHash:  return GetCommand::Matches(token) ? "read" : "unknown";
+    case SetCommand::kHash:  return SetCommand::Matches(token) ? "write" : "unknown";
+    case DelCommand::kHash:  return DelCommand::Matches(token) ? "delete" : "unknown";
+    case PingCommand::kHash: return PingCommand::Matches(token) ? "pong" : "unknown";
+    default:                 return "unknown";
+  }
+}
+
 int main() {
+  // 之后所有用默认 resource 的 MyString 都从这里申请内存：堆分配次数在 Release 构建下也能数
+  CountingResource heap;
+  std::pmr::set_default_resource(&heap);
+
   std::cout << "=== The Cost of Copying: Vector Reallocation Demo ===" << std::endl;
 
-  // 创建一个容器
   std::vector<MyString> vec;
 
-  // 这里的预期是：只打印 3 次拷贝构造日志？
-  // 实际上：你会看到大量的 "Deep copy"！
-  // 观察当 i 增加时，旧的元素是如何被反复拷贝的。
+  // push_back(std::move(temp)) 走移动构造；vector 扩容搬旧元素时，因为移动构造是 noexcept 的，
+  // 也是移动而不是深拷贝。观察每一轮 copies 始终为 0、moves 随扩容增加。
+  // (拷贝 / 移动次数来自 MyString::Stats，LIFECYCLE_STATS=0 时没有这些计数)
   for (int i = 0; i < 3; ++i) {
-    std::cout << "\n--- Iteration " << i << ": Pushing back ---" << std::endl;
-    
-    // 1. Construct a temporary string (Parameterized Constructor)
+    MyString::Stats::Snapshot before = MyString::Stats::Get();
+
     MyString temp("Hello World");
-    
-    // 2. Push into vector (Triggers Copy Constructor)
-    // 如果 vector 需要扩容，它还会把旧元素一个个拷贝到新家
-    // vec.push_back(temp);
-    // std::move 把 temp 伪装成了右值，Vector 一看是右值，立马调用 Move Constructor
     vec.push_back(std::move(temp));
+
+    MyString::Stats::Snapshot after = MyString::Stats::Get();
+    if constexpr (MyString::Stats::kEnabled) {
+      std::cout << "--- Iteration " << i << ": copies +" << after.copies - before.copies
+                << ", moves +" << after.moves - before.moves << std::endl;
+    } else {
+      std::cout << "--- Iteration " << i << ": copies / moves not counted (LIFECYCLE_STATS=0)" << std::endl;
+    }
+  }
+
+  // SSO 实验：短串 (<= 23 字节) 全程不碰堆，长串每个对象 1 次 new[] (扩容时只是移动指针，不会再分配)
+  std::cout << "\n=== SSO: Heap Allocations in Vector Reallocation ===" << std::endl;
+  uint64_t short_allocs = PushAndCountAllocs("Hello World", 3, heap);
+  uint64_t long_allocs = PushAndCountAllocs("This payload is definitely longer than 23 bytes", 3, heap);
+  std::cout << "short payload (" << std::strlen("Hello World") << " bytes): "
+            << short_allocs << " heap allocations" << std::endl;   // Expect: 0
+  std::cout << "long payload: " << long_allocs << " heap allocations" << std::endl;  // Expect: 3
+
+  // 增量构建：逐段拼出一个响应串。几何扩容下 1000 次 Append 只需要 O(log n) 次分配
+  std::cout << "\n=== Incremental Build: Append with Amortized Capacity ===" << std::endl;
+  {
+    uint64_t before = heap.allocations();
+    MyString response(&heap);
+    for (int i = 0; i < 1000; ++i) {
+      response += "HTTP/1.1 200 OK";
+      response.PushBack('\n');
+    }
+    uint64_t allocs = heap.allocations() - before;
+    std::cout << "size=" << response.size() << " capacity=" << response.capacity()
+              << " heap allocations=" << allocs << std::endl;  // Expect: ~10 次 (而不是 2000 次)
   }
 
+  // 零拷贝解析：用 MyStringView 把请求行切成 token，全程不分配内存
+  std::cout << "\n=== Zero-Copy Parsing with MyStringView ===" << std::endl;
+  {
+    MyString request("  GET /api/v1/users?id=42 HTTP/1.1\r\n");
+    MyString::Stats::Snapshot before = MyString::Stats::Get();
+    uint64_t allocs_before = heap.allocations();
+
+    MyStringView line = MyStringView(request).Trim();
+    int index = 0;
+    for (MyStringView token : line.Split(' ')) {
+      std::cout << "token[" << index++ << "] = \"" << token << "\"" << std::endl;
+    }
+    MyStringView path = line.Substr(line.Find(' ') + 1);
+    path = path.Substr(0, path.Find(' '));
+    MyStringView query = path.Substr(path.Find('?') + 1);
+    std::cout << "path = \"" << path << "\", query = \"" << query << "\"" << std::endl;
+
+    MyString::Stats::Snapshot after = MyString::Stats::Get();
+    std::cout << "heap allocations +" << heap.allocations() - allocs_before;  // Expect: 0
+    if constexpr (MyString::Stats::kEnabled) {
+      std::cout << ", constructions +" << after.constructions - before.constructions;  // Expect: 0
+    }
+    std::cout << std::endl;
+  }
+
+  // 请求级 arena：处理一个请求期间的长串都从栈上的缓冲区里切，请求结束时整块丢掉，不逐个 delete。
+  // 上游设成 null_memory_resource：万一缓冲区不够就直接抛 bad_alloc，证明全程没有碰全局堆
+  std::cout << "\n=== Request Arena: std::pmr::monotonic_buffer_resource ===" << std::endl;
+  {
+    alignas(std::max_align_t) char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                              std::pmr::null_memory_resource());
+
+    MyString path("/api/v1/users/42/profile/settings", &arena);
+    MyString header("Content-Type: application/json; charset=utf-8", &arena);
+    MyString body(&arena);
+    for (int i = 0; i < 20; ++i) {
+      body += "{\"id\": 42}";  // 扩容时旧缓冲区还给 arena (monotonic：什么都不做)
+    }
+    MyString response(path + " -> " + header, &arena);
+
+    // 同一个 arena 内移动：只换指针，不分配也不复制
+    const char* buffer_before = response.data();
+    MyString moved(std::move(response));
+    std::cout << "move within arena reuses buffer: " << std::boolalpha
+              << (moved.data() == buffer_before) << std::endl;  // Expect: true
+
+    // 移动到默认 resource 的字符串里：不能偷 arena 的内存 (arena 马上就要整块释放了)，退化成一次深拷贝
+    MyString survivor;
+    survivor = std::move(moved);
+    std::cout << "move out of arena reuses buffer: " << (survivor.data() == buffer_before)
+              << std::endl;  // Expect: false
+    std::cout << "body size=" << body.size() << " capacity=" << body.capacity() << std::endl;
+  }  // arena 析构：所有字符串的内存一次性作废 (字符串自己先析构，deallocate 是空操作)
+
+  // 编译期 key：FixedString 全部在对象内部，NTTP + constexpr 哈希做命令分派
+  std::cout << "\n=== Compile-time Keys: FixedString<N> Dispatch ===" << std::endl;
+  {
+    MyString line("SET user:42 alice\r\nPING\r\nGET user:42\r\nQUIT\r\n");
+    uint64_t before = heap.allocations();
+
+    for (MyStringView command : MyStringView(line).Split('\n')) {
+      command = command.Trim();
+      if (command.empty()) continue;
+      MyStringView name = command.Substr(0, command.Find(' '));
+      std::cout << name << " -> " << Dispatch(name) << std::endl;
+    }
+
+    std::cout << "heap allocations +" << heap.allocations() - before << std::endl;  // Expect: 0
+
+    // 与 MyString 互相转换：FixedString -> MyString 深拷贝，MyString -> FixedString 超长时抛异常
+    FixedString<16> key(MyString("user:42"));
+    MyString owned(key);
+    std::cout << "round trip: " << owned.c_str() << " (capacity " << key.capacity() << ")" << std::endl;
+  }
+
+  std::cout << "\n=== Lifecycle Summary ===" << std::endl;
+  MyString::Stats::PrintSummary("MyString");
+
   std::cout << "\n=== Demo Finished ===" << std::endl;
   return 0;
 }
 
-/*
-========================================================================================================================
-vector底层扩容机制: 
-1. 对待“老员工” (扩容搬家) -> 智能移动    场景：Vector 容量不够了，需要搬家。
-   Vector 的思考：
-     “我要把老内存里的 MyString 搬到新内存去。我看了一下 MyString 的代码，发现它有 移动构造函数，而且还贴心地标了 noexcept。既然这样，我就不费劲复制了，直接把它们‘偷’（Move）过去！”
-     结果：最后那两行 [移动构造]。这是极大的性能优化！(如果没有移动构造，这里就会是两次深拷贝)。
-
-2. 对待“新员工” (push_back) -> 保守拷贝  场景：你调用 vec.push_back(temp)。
-   Vector 的思考：
-     “用户传给我的是 temp。这是一个 左值 (L-value)，也就是一个有名字的变量。根据 C++ 法律，只要变量有名字，就说明用户后面可能还要用它。所以我绝不能偷它的资源，我必须老老实实地 拷贝 (Copy) 一份。”
-     结果：你看到了第二行的 ---- 拷贝构造(Deep Copy) -----。
-    如果我们不需要这个temp了，也可以让 push_back 变智能 ———————— 需要把 左值 变成 右值。
-
-注意：
-这个 noexcept 起什么作用：
-  它告诉 std::vector：“放心大胆地用移动构造吧！我保证在搬运数据的过程中绝不会报错（抛出异常）。”
-  如果没有这个 noexcept，std::vector 为了数据安全，即使你写了移动构造函数，它也会视而不见，强制降级去调用拷贝构造函数（Deep Copy）。
-*/
\ No newline at end of file
@@ -1,59 +1,74 @@
 #include <iostream>
-#include <cstring> // 用于 strlen, strcpy
+#include <cstring> // 用于 strlen, memcpy
 
 #include "my_string.hpp"
 
 // 1. 默认构造
-MyString::MyString() {
-  std::cout << "---- 默认构造 -----" << std::endl;
-  data_ = new char[1]; 
-  data_[0] = '\0';     // 设置结束符
-  length_ = 0;
+// 空串直接指向内部缓冲区，零次堆分配
+MyString::MyString() : MyString(std::pmr::get_default_resource()) {}
+
+MyString::MyString(std::pmr::memory_resource* resource)
+    : data_(local_buf_), length_(0), resource_(resource) {
+  Stats::OnConstruct();
+  local_buf_[0] = '\0';     // 设置结束符
 }
 
 // 2. 有参构造
-MyString::MyString(const char* str) {
-  std::cout << "---- 有参构造(const char*) -----" << std::endl;
+MyString::MyString(const char* str, std::pmr::memory_resource* resource) : resource_(resource) {
+  Stats::OnConstruct();
   if (str == nullptr) {
-    data_ = new char[1];
-    data_[0] = '\0';
-    length_ = 0;
+    InitFrom("", 0);
   } else {
-    length_ = std::strlen(str);
-    data_ = new char[length_ + 1];
-    std::strcpy(data_, str);
+    InitFrom(str, std::strlen(str));
   }
 }
 
+// 从视图深拷贝
+MyString::MyString(MyStringView view, std::pmr::memory_resource* resource)
+    : resource_(resource) {
+  Stats::OnConstruct();
+  InitFrom(view.data(), view.size());
+}
+
 // 3. 拷贝构造 (Deep Copy)
-// 痛点：每次拷贝都要重新申请内存，非常慢！
-MyString::MyString(const MyString& other) {
-  std::cout << "---- 拷贝构造(Deep Copy) -----" << std::endl;
-  length_ = other.length_;
-  data_ = new char[length_ + 1];
-  std::strcpy(data_, other.data_);
+// 痛点：长串每次拷贝都要重新申请内存，非常慢！(短串只是复制 24 字节)
+// 副本不继承 other 的 resource：arena 里的字符串被拷贝出去以后，可能比 arena 活得更久
+MyString::MyString(const MyString& other) : MyString(other, std::pmr::get_default_resource()) {}
+
+MyString::MyString(const MyString& other, std::pmr::memory_resource* resource)
+    : resource_(resource) {
+  Stats::OnConstruct();
+  Stats::OnCopy();
+  InitFrom(other.data_, other.length_);
 }
 
 // 4. 拷贝赋值运算符 (Deep Copy)
 MyString& MyString::operator=(const MyString& other) {
-  std::cout << "---- 拷贝赋值运算符(Deep Copy) -----" << std::endl;
-
   // [非常重要] 1. 自赋值检测
   // 防止 s1 = s1 时，先把自己的肉割了，导致后面没法读
   if (this == &other) {
     return *this;
   }
+  Stats::OnCopy();
 
-  // 2. 释放旧内存
-  // 注意：对应 new[]，这里必须用 delete[]
-  if (data_) {
-    delete[] data_;
+  // 2. 现有容量放得下：直接覆盖，复用缓冲区，不用 delete + new
+  if (other.length_ <= capacity()) {
+    std::memcpy(data_, other.data_, other.length_ + 1);
+    length_ = other.length_;
+    Stats::OnBytesCopied(length_);
+    return *this;
   }
 
-  // 3. 申请新内存并复制
+  // 3. 放不下 (一定是长串)：先在新内存里备好副本，再释放旧内存 (和 Reserve / Append 的顺序一样)。
+  //    Allocate 可能抛异常 (比如 arena 用完了)：这时 *this 原封不动，析构也不会把旧内存再释放一次
+  char* new_data = Allocate(other.length_);
+  std::memcpy(new_data, other.data_, other.length_ + 1);
+  Stats::OnBytesCopied(other.length_);
+
+  FreeHeap();
+  data_ = new_data;
+  capacity_ = other.length_;
   length_ = other.length_;
-  data_ = new char[length_ + 1];
-  std::strcpy(data_, other.data_);
 
   // 4. 返回对象本身
   return *this;
@@ -62,47 +77,202 @@ MyString& MyString::operator=(const MyString& other) {
 // 5. 析构
 // 写法是 MyString::~MyString
 MyString::~MyString() {
-  // delete[] 对 nullptr 是安全的，所以其实不用 if (data_) 判断
-  // 但为了逻辑清晰，保留判断也可以
-  if (data_) {
-    delete[] data_; // 必须用 delete[] 匹配 new[]
-  }
+  FreeHeap();
 }
 
 // 6. 移动构造
-MyString::MyString(MyString&& other) noexcept {
-  std::cout << "[移动构造] Stealing resources!" << std::endl;
-  // 1. 偷窃
-  length_ = other.length_;
-  data_ = other.data_;
+MyString::MyString(MyString&& other) noexcept
+    : length_(other.length_), resource_(other.resource_) {
+  Stats::OnConstruct();
+  Stats::OnMove();
+  if (other.IsLocal()) {
+    // 短串：没有堆指针可偷，直接复制内部缓冲区 (含 \0)
+    data_ = local_buf_;
+    std::memcpy(local_buf_, other.local_buf_, length_ + 1);
+    Stats::OnBytesCopied(length_);
+  } else {
+    // 长串：1. 偷窃堆指针 (连同容量；resource 已经在初始化列表里一起接管了)
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+  }
 
-  // 2. 释放 other 的资源
-  other.length_ = 0;
-  other.data_ = nullptr; // 关键：置空，防止对方析构时 delete 我们的数据
+  // 2. 把 other 重置为 SSO 空串
+  // 关键：other 不再指向我们的堆内存，防止对方析构时 delete 我们的数据
+  other.ResetToEmpty();
 }
 
 // 7. 移动赋值
-MyString& MyString::operator=(MyString&& other) noexcept {
+MyString& MyString::operator=(MyString&& other) {
   // 1. 判断是否为同一个对象
   if (this == &other) return *this;
 
+  // resource 不同：other 的堆内存将来必须还给 other 的 resource，不能偷过来由我们释放，
+  // 只能退化成拷贝 (在自己的 resource 里重新分配)。other 保持原样，依然有效
+  if (resource_ != other.resource_ && !resource_->is_equal(*other.resource_)) {
+    return *this = other;
+  }
+  Stats::OnMove();
+
   // 2. 先释放this的资源，防止内存泄漏
-  delete[] data_;
-  
+  FreeHeap();
+
   length_ = other.length_;
-  data_ = other.data_;
+  if (other.IsLocal()) {
+    data_ = local_buf_;
+    std::memcpy(local_buf_, other.local_buf_, length_ + 1);
+    Stats::OnBytesCopied(length_);
+  } else {
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+  }
 
   // 3. 释放 other 的资源
-  other.length_ = 0;
-  other.data_ = nullptr;
+  other.ResetToEmpty();
   return *this;
 }
 
 
 void MyString::Print() const {
   // 直接打印 char* 即可，cout 会自动处理
-  if (data_) {
-    std::cout << data_ << std::endl;
+  std::cout << data_ << std::endl;
+}
+
+void MyString::Reserve(size_t new_capacity) {
+  if (new_capacity <= capacity()) {
+    return;
+  }
+
+  char* new_data = Allocate(new_capacity);
+  std::memcpy(new_data, data_, length_ + 1);  // 长度已知，直接 memcpy (连同 \0)，不用 strcpy 重新扫描
+  Stats::OnBytesCopied(length_);
+
+  FreeHeap();
+  data_ = new_data;
+  capacity_ = new_capacity;
+}
+
+void MyString::Append(const char* str, size_t len) {
+  if (len == 0) {
+    return;
+  }
+
+  size_t new_length = length_ + len;
+  if (new_length > capacity()) {
+    // 扩容：注意 str 可能指向自己的旧缓冲区，所以必须先复制新内容，再释放旧内存
+    size_t new_capacity = std::max(new_length, 2 * capacity());
+    char* new_data = Allocate(new_capacity);
+    std::memcpy(new_data, data_, length_);
+    std::memcpy(new_data + length_, str, len);
+    Stats::OnBytesCopied(new_length);
+
+    FreeHeap();
+    data_ = new_data;
+    capacity_ = new_capacity;
+  } else {
+    // 容量够用：原地追加 (即使 str 指向自身，源区间 [0, length_) 与目标区间也不重叠)
+    std::memcpy(data_ + length_, str, len);
+    Stats::OnBytesCopied(len);
+  }
+
+  length_ = new_length;
+  data_[length_] = '\0';
+}
+
+void MyString::Append(const char* str) {
+  if (str != nullptr) {
+    Append(str, std::strlen(str));
+  }
+}
+
+void MyString::Append(const MyString& other) {
+  Append(other.data_, other.length_);
+}
+
+void MyString::PushBack(char ch) {
+  if (length_ == capacity()) {
+    Grow(length_ + 1);
   }
+  data_[length_++] = ch;
+  data_[length_] = '\0';
 }
 
+MyString& MyString::operator+=(const MyString& other) {
+  Append(other);
+  return *this;
+}
+
+MyString& MyString::operator+=(const char* str) {
+  Append(str);
+  return *this;
+}
+
+MyString& MyString::operator+=(char ch) {
+  PushBack(ch);
+  return *this;
+}
+
+void MyString::Clear() {
+  length_ = 0;
+  data_[0] = '\0';
+}
+
+size_t MyString::Find(char ch, size_t pos) const {
+  return MyStringView(*this).Find(ch, pos);
+}
+
+size_t MyString::Find(MyStringView needle, size_t pos) const {
+  return MyStringView(*this).Find(needle, pos);
+}
+
+int MyString::Compare(MyStringView other) const {
+  return MyStringView(*this).Compare(other);
+}
+
+size_t MyString::Hash() const {
+  return static_cast<size_t>(ActiveKernels().hash(data_, length_));
+}
+
+bool operator==(const MyString& lhs, const MyString& rhs) {
+  // 长度不同直接判否，不用看内容
+  return lhs.length_ == rhs.length_ &&
+         ActiveKernels().compare(lhs.data_, rhs.data_, lhs.length_) == 0;
+}
+
+bool operator==(const MyString& lhs, const char* rhs) {
+  return MyStringView(lhs) == MyStringView(rhs);
+}
+
+void MyString::InitFrom(const char* str, size_t len) {
+  length_ = len;
+  if (len <= kLocalCapacity) {
+    data_ = local_buf_;         // 短串：放进对象内部
+  } else {
+    data_ = Allocate(len);      // 长串：才去找分配器 (容量恰好等于长度)
+    capacity_ = len;
+  }
+  std::memcpy(data_, str, len);
+  data_[len] = '\0';
+  Stats::OnBytesCopied(len);
+}
+
+char* MyString::Allocate(size_t capacity) const {
+  Stats::OnAllocate(capacity + 1);
+  return static_cast<char*>(resource_->allocate(capacity + 1, alignof(char)));
+}
+
+void MyString::Grow(size_t min_capacity) {
+  Reserve(std::max(min_capacity, 2 * capacity()));
+}
+
+void MyString::FreeHeap() {
+  // 大小和对齐必须与 allocate 时一致；SSO 状态下 data_ 指向自身，绝不能释放
+  if (!IsLocal()) {
+    resource_->deallocate(data_, capacity_ + 1, alignof(char));
+  }
+}
+
+void MyString::ResetToEmpty() {
+  data_ = local_buf_;
+  length_ = 0;
+  local_buf_[0] = '\0';
+}
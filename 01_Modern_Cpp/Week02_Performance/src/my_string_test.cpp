@@ -0,0 +1,96 @@
+// src/my_string_test.cpp
+// MyString 的异常安全测试：resource 分配失败 (抛 bad_alloc) 时，被赋值的字符串必须原封不动，
+// 析构时也不能把同一块内存释放两次。
+#include <cstring>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <set>
+#include <string>
+
+#include "my_string.hpp"
+
+int g_failures = 0;
+
+void Check(bool ok, const std::string& what) {
+  if (!ok) {
+    ++g_failures;
+    std::cout << "❌ " << what << std::endl;
+  }
+}
+
+// 只允许分配 budget 次，再要就抛 bad_alloc (模拟 arena 用完)。
+// 记下每一块还没还的内存：重复释放 / 释放不认识的指针都算错，而不是真的去 free 第二次
+class LimitedResource : public std::pmr::memory_resource {
+public:
+  explicit LimitedResource(int budget) : budget_(budget) {}
+
+  size_t live() const { return live_.size(); }
+  int bad_frees() const { return bad_frees_; }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    if (budget_ == 0) {
+      throw std::bad_alloc();
+    }
+    --budget_;
+    void* p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    live_.insert(p);
+    return p;
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    if (live_.erase(p) == 0) {
+      ++bad_frees_;  // 已经还过了：这正是要抓的二次释放
+      return;
+    }
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  int budget_;
+  int bad_frees_ = 0;
+  std::set<void*> live_;
+};
+
+// 拷贝赋值放不下、重新分配时抛异常：旧内容和旧缓冲区都还在
+void TestCopyAssignThrows(const char* initial, const char* what) {
+  LimitedResource resource(MyString(initial).IsLocal() ? 0 : 1);  // 只够 initial 自己用
+  MyString source("This source string is much longer than the target's current capacity");
+  bool threw = false;
+  {
+    MyString target(initial, &resource);
+    const char* buffer_before = target.data();
+    try {
+      target = source;
+    } catch (const std::bad_alloc&) {
+      threw = true;
+    }
+    Check(threw, std::string(what) + ": copy assignment should throw bad_alloc");
+    Check(target.data() == buffer_before, std::string(what) + ": buffer unchanged after throw");
+    Check(std::strcmp(target.c_str(), initial) == 0 && target.size() == std::strlen(initial),
+          std::string(what) + ": content unchanged after throw");
+  }
+  Check(resource.bad_frees() == 0, std::string(what) + ": no double free");
+  Check(resource.live() == 0, std::string(what) + ": no leak");
+}
+
+int main() {
+  std::cout << "--- MyString Exception Safety Test ---" << std::endl;
+
+  TestCopyAssignThrows("a heap string that is longer than 23 bytes", "heap target");
+  TestCopyAssignThrows("short", "SSO target");
+
+  // 放得下的正常路径：复用缓冲区，不再分配
+  {
+    LimitedResource resource(1);
+    MyString target("a heap string that is longer than 23 bytes", &resource);
+    MyString source("a shorter heap string, 24+");
+    target = source;
+    Check(target == source && resource.live() == 1, "copy assignment reuses buffer when it fits");
+  }
+
+  std::cout << (g_failures == 0 ? "✅ passed" : "❌ failed") << std::endl;
+  return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#include <mutex>
+
+#include "string_interner.hpp"
+
+StringInterner::StringInterner(size_t shard_count) {
+  size_t count = 1;
+  while (count < shard_count) {
+    count <<= 1;
+  }
+  shards_ = std::make_unique<Shard[]>(count);
+  shard_mask_ = count - 1;
+}
+
+InternedString StringInterner::Intern(MyStringView str) {
+  if (str.empty()) {
+    return InternedString();
+  }
+
+  size_t hash = str.Hash();
+  Shard& shard = ShardFor(hash);
+
+  // 1. 快路径：读锁查找。绝大多数调用在这里就返回了
+  {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(Key{str, hash});
+    if (it != shard.index.end()) {
+      return InternedString(it->second);
+    }
+  }
+
+  // 2. 慢路径：写锁插入。拿读锁到拿写锁之间可能有别的线程插入了同一个字符串，所以要再查一次
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.index.find(Key{str, hash});
+  if (it != shard.index.end()) {
+    return InternedString(it->second);
+  }
+
+  Entry& entry = shard.storage.emplace_back(
+      Entry{MyString(str), hash, next_id_.fetch_add(1, std::memory_order_relaxed)});
+  // key 里的视图指向池里的副本，而不是调用者传进来的 (可能马上就失效的) 缓冲区
+  shard.index.emplace(Key{MyStringView(entry.str), hash}, &entry);
+  return InternedString(&entry);
+}
+
+bool StringInterner::Find(MyStringView str, InternedString* out) const {
+  if (str.empty()) {
+    *out = InternedString();
+    return true;
+  }
+
+  size_t hash = str.Hash();
+  const Shard& shard = ShardFor(hash);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.index.find(Key{str, hash});
+  if (it == shard.index.end()) {
+    return false;
+  }
+  *out = InternedString(it->second);
+  return true;
+}
@@ -0,0 +1,326 @@
+#include <atomic>
+#include <cstring> // 用于 memcmp, memcpy
+
+#if defined(__x86_64__) || defined(__i386__)
+#define STRING_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#include "string_simd.hpp"
+
+namespace {
+
+// ------------------------- CRC32C 查表 (slicing-by-8) -------------------------
+// 多项式 0x1EDC6F41 (反射形式 0x82F63B78)，与 x86 的 crc32 指令以及头文件里的 ConstexprHash 一致。
+// 8 张表在编译期生成：一次吞 8 个字节，比逐字节查表快好几倍。
+constexpr uint32_t kCrc32cPoly = 0x82F63B78u;
+
+struct Crc32cTables {
+  uint32_t table[8][256];
+};
+
+constexpr Crc32cTables MakeCrc32cTables() {
+  Crc32cTables t{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ kCrc32cPoly : crc >> 1;
+    }
+    t.table[0][i] = crc;
+  }
+  for (int k = 1; k < 8; ++k) {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t prev = t.table[k - 1][i];
+      t.table[k][i] = (prev >> 8) ^ t.table[0][prev & 0xFF];
+    }
+  }
+  return t;
+}
+
+constexpr Crc32cTables kCrc32c = MakeCrc32cTables();
+
+// ------------------------- Scalar：逐字节 -------------------------
+size_t ScalarFindChar(const char* data, size_t len, char ch) {
+  for (size_t i = 0; i < len; ++i) {
+    if (data[i] == ch) {
+      return i;
+    }
+  }
+  return kNotFound;
+}
+
+int ScalarCompare(const char* lhs, const char* rhs, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    if (lhs[i] != rhs[i]) {
+      // 必须按无符号比较，否则 0x80 以上的字节会被当成负数
+      return static_cast<unsigned char>(lhs[i]) - static_cast<unsigned char>(rhs[i]);
+    }
+  }
+  return 0;
+}
+
+size_t ScalarFind(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len) {
+  if (needle_len == 0) {
+    return 0;
+  }
+  if (needle_len > haystack_len) {
+    return kNotFound;
+  }
+  for (size_t i = 0; i + needle_len <= haystack_len; ++i) {
+    if (haystack[i] == needle[0] && ScalarCompare(haystack + i, needle, needle_len) == 0) {
+      return i;
+    }
+  }
+  return kNotFound;
+}
+
+uint64_t ScalarHash(const char* data, size_t len) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data);
+  const size_t total = len;
+  uint32_t crc = ~0u;
+  // 小端序下一次处理 8 个字节
+  while (len >= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    word ^= crc;
+    crc = kCrc32c.table[7][word & 0xFF] ^
+          kCrc32c.table[6][(word >> 8) & 0xFF] ^
+          kCrc32c.table[5][(word >> 16) & 0xFF] ^
+          kCrc32c.table[4][(word >> 24) & 0xFF] ^
+          kCrc32c.table[3][(word >> 32) & 0xFF] ^
+          kCrc32c.table[2][(word >> 40) & 0xFF] ^
+          kCrc32c.table[1][(word >> 48) & 0xFF] ^
+          kCrc32c.table[0][word >> 56];
+    p += 8;
+    len -= 8;
+  }
+  while (len-- > 0) {
+    crc = kCrc32c.table[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+  }
+  return MixCrcHash(~crc, total);
+}
+
+const StringKernels kScalarKernels = {ScalarFindChar, ScalarFind, ScalarCompare, ScalarHash};
+
+#ifdef STRING_SIMD_X86
+// ------------------------- SSE2：一次 16 字节 -------------------------
+// 思路：_mm_cmpeq_epi8 逐字节比较得到 0x00/0xFF 掩码，_mm_movemask_epi8 把 16 个字节的最高位压成一个 int，
+// 再用 __builtin_ctz 找到第一个命中的位置。整块都不命中时一条分支就跳过 16 个字节。
+
+__attribute__((target("sse2")))
+size_t Sse2FindChar(const char* data, size_t len, char ch) {
+  const __m128i pattern = _mm_set1_epi8(ch);
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  // 尾部不足 16 字节：逐字节处理，绝不越界读
+  size_t pos = ScalarFindChar(data + i, len - i, ch);
+  return pos == kNotFound ? kNotFound : i + pos;
+}
+
+__attribute__((target("sse2")))
+int Sse2Compare(const char* lhs, const char* rhs, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    if (mask != 0xFFFFu) {
+      size_t pos = i + __builtin_ctz(~mask);
+      return static_cast<unsigned char>(lhs[pos]) - static_cast<unsigned char>(rhs[pos]);
+    }
+  }
+  return ScalarCompare(lhs + i, rhs + i, len - i);
+}
+
+// 子串查找 (Wojciech Muła 的 "generic SIMD" 算法)：
+// 同时比较 needle 的首字符和尾字符，两者都命中的位置才去 memcmp 中间部分，绝大多数候选在 SIMD 阶段就被过滤掉
+__attribute__((target("sse2")))
+size_t Sse2Find(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len) {
+  if (needle_len <= 1) {
+    return needle_len == 0 ? 0 : Sse2FindChar(haystack, haystack_len, needle[0]);
+  }
+  if (needle_len > haystack_len) {
+    return kNotFound;
+  }
+
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+  size_t i = 0;
+  for (; i + needle_len - 1 + 16 <= haystack_len; i += 16) {
+    __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    __m128i block_last =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needle_len - 1));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+    while (mask != 0) {
+      size_t pos = i + __builtin_ctz(mask);
+      if (std::memcmp(haystack + pos + 1, needle + 1, needle_len - 2) == 0) {
+        return pos;
+      }
+      mask &= mask - 1;  // 清掉最低位的 1，看下一个候选
+    }
+  }
+  size_t pos = ScalarFind(haystack + i, haystack_len - i, needle, needle_len);
+  return pos == kNotFound ? kNotFound : i + pos;
+}
+
+// ------------------------- AVX2：一次 32 字节 -------------------------
+__attribute__((target("avx2")))
+size_t Avx2FindChar(const char* data, size_t len, char ch) {
+  const __m256i pattern = _mm256_set1_epi8(ch);
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  size_t pos = Sse2FindChar(data + i, len - i, ch);
+  return pos == kNotFound ? kNotFound : i + pos;
+}
+
+__attribute__((target("avx2")))
+int Avx2Compare(const char* lhs, const char* rhs, size_t len) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    if (mask != 0xFFFFFFFFu) {
+      size_t pos = i + __builtin_ctz(~mask);
+      return static_cast<unsigned char>(lhs[pos]) - static_cast<unsigned char>(rhs[pos]);
+    }
+  }
+  return Sse2Compare(lhs + i, rhs + i, len - i);
+}
+
+__attribute__((target("avx2")))
+size_t Avx2Find(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len) {
+  if (needle_len <= 1) {
+    return needle_len == 0 ? 0 : Avx2FindChar(haystack, haystack_len, needle[0]);
+  }
+  if (needle_len > haystack_len) {
+    return kNotFound;
+  }
+
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+  size_t i = 0;
+  for (; i + needle_len - 1 + 32 <= haystack_len; i += 32) {
+    __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+    __m256i block_last =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + needle_len - 1));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+    while (mask != 0) {
+      size_t pos = i + __builtin_ctz(mask);
+      if (std::memcmp(haystack + pos + 1, needle + 1, needle_len - 2) == 0) {
+        return pos;
+      }
+      mask &= mask - 1;
+    }
+  }
+  size_t pos = Sse2Find(haystack + i, haystack_len - i, needle, needle_len);
+  return pos == kNotFound ? kNotFound : i + pos;
+}
+
+// 硬件 CRC32C：crc32 指令属于 SSE4.2，所有支持 AVX2 的 CPU 都有
+__attribute__((target("sse4.2")))
+uint64_t HardwareHash(const char* data, size_t len) {
+  uint64_t crc = ~0u;
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, 8);
+    crc = _mm_crc32_u64(crc, word);
+  }
+  uint32_t crc32 = static_cast<uint32_t>(crc);
+  for (; i < len; ++i) {
+    crc32 = _mm_crc32_u8(crc32, static_cast<unsigned char>(data[i]));
+  }
+  return MixCrcHash(~crc32, len);
+}
+
+// SSE2 没有 CRC 指令，哈希沿用查表法 (slicing-by-8 本身已经不是逐字节了)
+const StringKernels kSse2Kernels = {Sse2FindChar, Sse2Find, Sse2Compare, ScalarHash};
+const StringKernels kAvx2Kernels = {Avx2FindChar, Avx2Find, Avx2Compare, HardwareHash};
+#endif  // STRING_SIMD_X86
+
+// 当前使用的内核表。函数内 static：第一次调用时才探测 CPU，避免静态初始化顺序问题
+std::atomic<const StringKernels*>& ActiveSlot() {
+  static std::atomic<const StringKernels*> slot{&KernelsFor(DetectSimdLevel())};
+  return slot;
+}
+
+}  // namespace
+
+SimdLevel DetectSimdLevel() {
+#ifdef STRING_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2")) {
+    return SimdLevel::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::kSse2;
+  }
+#endif
+  return SimdLevel::kScalar;
+}
+
+const StringKernels& KernelsFor(SimdLevel level) {
+#ifdef STRING_SIMD_X86
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return kAvx2Kernels;
+    case SimdLevel::kSse2:
+      return kSse2Kernels;
+    case SimdLevel::kScalar:
+      break;
+  }
+#else
+  (void)level;
+#endif
+  return kScalarKernels;
+}
+
+SimdLevel ActiveSimdLevel() {
+  const StringKernels* active = ActiveSlot().load(std::memory_order_relaxed);
+#ifdef STRING_SIMD_X86
+  if (active == &kAvx2Kernels) return SimdLevel::kAvx2;
+  if (active == &kSse2Kernels) return SimdLevel::kSse2;
+#endif
+  (void)active;
+  return SimdLevel::kScalar;
+}
+
+void SetSimdLevel(SimdLevel level) {
+  SimdLevel supported = DetectSimdLevel();
+  if (static_cast<int>(level) > static_cast<int>(supported)) {
+    level = supported;
+  }
+  // 内核表都是静态常量，指针本身的读写用 relaxed 即可
+  ActiveSlot().store(&KernelsFor(level), std::memory_order_relaxed);
+}
+
+const char* SimdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kSse2:
+      return "sse2";
+    case SimdLevel::kScalar:
+      break;
+  }
+  return "scalar";
+}
+
+const StringKernels& ActiveKernels() {
+  return *ActiveSlot().load(std::memory_order_relaxed);
+}
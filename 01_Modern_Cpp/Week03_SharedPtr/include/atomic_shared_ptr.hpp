@@ -0,0 +1,185 @@
+#ifndef Week03_SHAREDPTR_INCLUDE_ATOMIC_SHARED_PTR_HPP_
+#define Week03_SHAREDPTR_INCLUDE_ATOMIC_SHARED_PTR_HPP_
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "shared_ptr.hpp"
+
+// 原子共享指针 (AtomicSharedPtr)
+//
+// SharedPtr 的原子计数只保证"每个线程各拿一份拷贝"是安全的；多个线程同时读写**同一个** SharedPtr 变量
+// (典型场景：一个线程发布新配置 / 路由表，很多线程读当前快照) 仍然是数据竞争，
+// 因为"读出控制块指针"和"给它的计数 +1"是两步：中间写线程可能已经换掉并释放了旧对象。
+// 最简单的解法是加一把 mutex，但读者之间也会互相排队。
+//
+// 这里用"拆分引用计数 (split reference count)"，读者不拿锁：
+//   1. 控制块指针和一个 16 位的"本地计数 (local)"打包进同一个 std::atomic<uint64_t>：
+//        [ local (高 16 位) | ControlBlock* (低 48 位) ]
+//   2. 发布 (Store / Exchange) 时，AtomicSharedPtr 替读者预付 kPrepaid 个 strong 引用
+//   3. 读者 (Load) 只做一次 CAS：local +1，同时读出控制块指针 —— 拿走一个预付好的引用，
+//      这一步之后控制块保证活着 (预付的引用还没被归还)，不需要再改控制块上的计数
+//   4. 被换下来的旧值里 local 是多少，就说明读者拿走了多少个；写线程把剩下的 (kPrepaid - local) 个还回去
+//   5. local 用掉一半时，读者顺手再给控制块补 kRefill 个，并把 local 减回去
+//
+// 不变式：当前安装的控制块上，有 (kPrepaid - local) 个 strong 引用属于 AtomicSharedPtr，且 local < kPrepaid。
+// 所有账都记在控制块自己的 strong 上，所以同一个控制块被换下又装回 (ABA) 也不会算错。
+//
+// 是否无锁 (x86-64)：
+//   - 状态只有一个 64 位整数，std::atomic<uint64_t> 在 x86-64 上总是无锁的 (lock cmpxchg / xchg)
+//   - Load / Store / Exchange / CompareExchange 都不拿锁；唯一的等待是 Load 发现预付引用只剩 1 个 (有
+//     32767 个读者同时停在 CAS 和补货之间)，此时让出 CPU 等别人补货 —— 实际上碰不到
+//   - 48 位指针：x86-64 用户态地址 (4 级页表) 都小于 2^47，高 16 位总是 0。
+//     5 级页表 (LA57) 的机器上，内核只在 mmap 显式要求高地址时才给出 > 47 位的地址，Pack 里有 assert 兜底
+//
+// 限制：
+//   - 只比较控制块 (本项目的 SharedPtr 没有别名构造，控制块相同就是同一个对象)
+//   - 放进 AtomicSharedPtr 之后 SharedPtr::UseCount() 会包含预付的引用，看起来很大
+//   - 不可拷贝、不可移动 (和 std::atomic 一样)
+template <typename T>
+class AtomicSharedPtr {
+ public:
+  static constexpr bool kIsAlwaysLockFree = std::atomic<std::uint64_t>::is_always_lock_free;
+
+  AtomicSharedPtr() : state_(0) {}
+
+  explicit AtomicSharedPtr(SharedPtr<T> desired) : state_(Install(desired)) {}
+
+  ~AtomicSharedPtr() { Adopt(state_.load(std::memory_order_relaxed)); }
+
+  AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+  AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+  // 读一份一致的快照：要么是旧对象，要么是新对象，拿到后对象一直活到返回的 SharedPtr 放手
+  SharedPtr<T> Load() const {
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    while (true) {
+      if (Control(state) == nullptr) {
+        return SharedPtr<T>();
+      }
+      if (Local(state) == kPrepaid - 1) {
+        // 预付的只剩 AtomicSharedPtr 自己那一个：等正在补货的读者把 local 减回去
+        std::this_thread::yield();
+        state = state_.load(std::memory_order_relaxed);
+        continue;
+      }
+      // acquire：和 Store 的 release 配对，看得到发布者对对象的初始化
+      if (state_.compare_exchange_weak(state, state + kLocalOne, std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        break;
+      }
+    }
+
+    ControlBlock* control = Control(state);
+    if (Local(state) + 1 >= kRefill) {
+      Refill(control);
+    }
+    return SharedPtr<T>(static_cast<T*>(control->object), control);
+  }
+
+  void Store(SharedPtr<T> desired) { Exchange(std::move(desired)); }
+
+  // 换上 desired，返回旧值
+  SharedPtr<T> Exchange(SharedPtr<T> desired) {
+    std::uint64_t next = Install(desired);
+    return Adopt(state_.exchange(next, std::memory_order_acq_rel));
+  }
+
+  // 当前值的控制块和 expected 相同时换成 desired 并返回 true；
+  // 否则把 expected 更新为当前值并返回 false (和 std::atomic 一样，通常放在循环里)
+  bool CompareExchange(SharedPtr<T>& expected, SharedPtr<T> desired) {
+    ControlBlock* next_control = desired.control_;
+    std::uint64_t next = Install(desired);
+
+    std::uint64_t current = state_.load(std::memory_order_relaxed);
+    // 控制块相同、只是 local 变了 (有读者插进来)：重试就行
+    while (Control(current) == expected.control_) {
+      if (state_.compare_exchange_weak(current, next, std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+        Adopt(current);
+        return true;
+      }
+    }
+
+    // 失败：desired 没装上去，把 Install 预付的引用 (包括 desired 自己的那一个) 全部还回去
+    if (next_control) {
+      next_control->ReleaseStrong(kPrepaid);
+    }
+    expected = Load();
+    return false;
+  }
+
+  bool IsLockFree() const { return state_.is_lock_free(); }
+
+ private:
+  static_assert(sizeof(void*) == 8, "AtomicSharedPtr packs a 48-bit pointer into 64 bits");
+
+  static constexpr int kPointerBits = 48;
+  static constexpr std::uint64_t kPointerMask = (std::uint64_t{1} << kPointerBits) - 1;
+  static constexpr std::uint64_t kLocalOne = std::uint64_t{1} << kPointerBits;
+
+  // 每次安装预付多少个 strong 引用；local 最多到 kPrepaid - 1，16 位放得下
+  static constexpr int kPrepaid = 1 << 15;
+  // local 到一半就补货
+  static constexpr int kRefill = kPrepaid / 2;
+
+  static ControlBlock* Control(std::uint64_t state) {
+    return reinterpret_cast<ControlBlock*>(static_cast<std::uintptr_t>(state & kPointerMask));
+  }
+
+  static int Local(std::uint64_t state) { return static_cast<int>(state >> kPointerBits); }
+
+  static std::uint64_t Pack(ControlBlock* control) {
+    auto bits = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(control));
+    assert((bits & ~kPointerMask) == 0 && "control block address does not fit in 48 bits");
+    return bits;
+  }
+
+  // 接管 desired 的那一个引用，再预付 kPrepaid - 1 个，返回打包好的 (local = 0) 状态
+  static std::uint64_t Install(SharedPtr<T>& desired) {
+    ControlBlock* control = std::exchange(desired.control_, nullptr);
+    desired.ptr_ = nullptr;
+    if (control) {
+      control->AddStrong(kPrepaid - 1);
+    }
+    return Pack(control);
+  }
+
+  // 接管一个已经被换下来的状态：留一个引用交给返回值，其余 (kPrepaid - local - 1) 个还给控制块。
+  // 留着的那一个保证这里的 ReleaseStrong 不会归零
+  static SharedPtr<T> Adopt(std::uint64_t state) {
+    ControlBlock* control = Control(state);
+    if (control == nullptr) {
+      return SharedPtr<T>();
+    }
+    int surplus = kPrepaid - Local(state) - 1;
+    if (surplus > 0) {
+      control->ReleaseStrong(surplus);
+    }
+    return SharedPtr<T>(static_cast<T*>(control->object), control);
+  }
+
+  // 先给控制块加 kRefill 个引用，再把 local 减掉 kRefill (手里有刚拿到的引用，控制块不会在这期间被释放)。
+  // 指针已经被换掉，或者别的读者已经补过，就把加上的退回去
+  void Refill(ControlBlock* control) const {
+    control->AddStrong(kRefill);
+    std::uint64_t current = state_.load(std::memory_order_relaxed);
+    while (Control(current) == control && Local(current) >= kRefill) {
+      // release：保证写线程从 state_ 上看到 local 变小时，也看到了上面的 AddStrong，不会多还
+      if (state_.compare_exchange_weak(current, current - kRefill * kLocalOne, std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    control->ReleaseStrong(kRefill);
+  }
+
+  mutable std::atomic<std::uint64_t> state_;
+};
+
+static_assert(AtomicSharedPtr<int>::kIsAlwaysLockFree);
+
+#endif  // Week03_SHAREDPTR_INCLUDE_ATOMIC_SHARED_PTR_HPP_
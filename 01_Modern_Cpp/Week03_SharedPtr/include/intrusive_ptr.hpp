@@ -0,0 +1,151 @@
+#ifndef Week03_SHAREDPTR_INCLUDE_INTRUSIVE_PTR_HPP_
+#define Week03_SHAREDPTR_INCLUDE_INTRUSIVE_PTR_HPP_
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+// 侵入式智能指针 (Intrusive Pointer)
+//
+// SharedPtr 的计数放在单独的控制块里：从裸指针构造要多分配一次，SharedPtr 自己是两个指针 (对象 + 控制块)，
+// 还要为 WeakPtr 多背一个 weak 计数和两个销毁函数指针。
+// 侵入式的做法是让对象继承 RefCounted<Derived> (CRTP)，计数 ref_count_ 就是对象自己的一个成员：
+//   - 没有控制块，没有第二次分配，计数和对象在同一块内存里
+//   - IntrusivePtr 只有一个指针，和原生指针一样大
+//   - 从裸指针 (包括 this) 重新构造 IntrusivePtr 也是安全的，因为计数跟着对象走
+//   - 归零时 CRTP 直接 delete Derived*：Derived 是 final 的话不需要虚析构函数；
+//     Derived 还会被继承 (class TlsConn : public Conn)，~Derived 就必须是虚的 (编译期检查)
+// 代价：只能管理"自己愿意带计数器"的类型，int、第三方类没法用；也没有弱引用。
+
+// ------------------------- 计数策略 -------------------------
+// 跨线程共享的对象 (连接、缓冲区) 用原子计数；只在单线程里传来传去的对象用普通 int，省掉 lock 前缀
+
+// 原子计数：与 std::shared_ptr 相同的内存序
+//   - 加一用 relaxed：能拿到一个引用去拷贝，说明对象肯定活着，不需要同步任何数据
+//   - 减一用 acq_rel：release 保证我对对象的修改在 delete 之前可见，acquire 保证最后一个人 delete 时能看到别人的修改
+struct AtomicRefCount {
+  using Counter = std::atomic<int>;
+
+  static void Increment(Counter& count) { count.fetch_add(1, std::memory_order_relaxed); }
+
+  // 返回 true 表示减到了 0 (调用者负责销毁)
+  static bool Decrement(Counter& count) {
+    return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  static int Load(const Counter& count) { return count.load(std::memory_order_relaxed); }
+};
+
+// 非原子计数：只能在单线程里使用
+struct NonAtomicRefCount {
+  using Counter = int;
+
+  static void Increment(Counter& count) { ++count; }
+  static bool Decrement(Counter& count) { return --count == 0; }
+  static int Load(const Counter& count) { return count; }
+};
+
+// ------------------------- 混入基类 -------------------------
+// class Connection : public RefCounted<Connection> { ... };
+// CRTP：基类知道派生类的类型，计数归零时直接 delete Derived*。
+// 注意 IntrusivePtr<TlsConn> 通过 ADL 找到的是 IntrusivePtrRelease(const Conn*)：delete 的是基类指针，
+// 所以 Derived 要么是 final，要么有虚析构函数，否则编译失败 (见 IntrusivePtrRelease 里的 static_assert)
+template <typename Derived, typename Policy = AtomicRefCount>
+class RefCounted {
+public:
+  // 当前引用计数 (调试用，多线程下只是一个瞬时值)
+  int RefCount() const { return Policy::Load(ref_count_); }
+
+protected:
+  RefCounted() = default;
+
+  // 拷贝对象时不拷贝计数：新对象还没有任何 IntrusivePtr 指向它
+  RefCounted(const RefCounted&) {}
+  RefCounted& operator=(const RefCounted&) { return *this; }
+
+  // protected 且非虚：不能通过 RefCounted* 来 delete (归零时 delete 的是 Derived*，它是否需要虚析构见上)，
+  // 也不能单独创建一个 RefCounted 对象
+  ~RefCounted() = default;
+
+private:
+  // IntrusivePtr 通过 ADL 找到这两个函数 (同 boost::intrusive_ptr 的做法)
+  friend void IntrusivePtrAddRef(const Derived* object) {
+    Policy::Increment(static_cast<const RefCounted*>(object)->ref_count_);
+  }
+
+  friend void IntrusivePtrRelease(const Derived* object) {
+    // object 可能实际指向 Derived 的子类：没有虚析构时 delete 基类指针是未定义行为
+    static_assert(std::is_final_v<Derived> || std::has_virtual_destructor_v<Derived>,
+                  "RefCounted<Derived>: Derived must be final or have a virtual destructor");
+    if (Policy::Decrement(static_cast<const RefCounted*>(object)->ref_count_)) {
+      delete object;
+    }
+  }
+
+  // mutable：指向 const 对象的 IntrusivePtr 也要能改计数
+  mutable typename Policy::Counter ref_count_{0};
+};
+
+// ------------------------- 智能指针 -------------------------
+template <typename T>
+class IntrusivePtr {
+public:
+  IntrusivePtr() : ptr_(nullptr) {}
+
+  // 接管 ptr 并加一个引用。ptr 可以是刚 new 出来的 (计数 0 -> 1)，
+  // 也可以是已经被别的 IntrusivePtr 管理的对象 (例如 this)
+  explicit IntrusivePtr(T* ptr) : ptr_(ptr) {
+    if (ptr_) {
+      IntrusivePtrAddRef(ptr_);
+    }
+  }
+
+  ~IntrusivePtr() {
+    if (ptr_) {
+      IntrusivePtrRelease(ptr_);
+    }
+  }
+
+  // 拷贝：计数 +1，仍然只是改对象内部的一个字段
+  IntrusivePtr(const IntrusivePtr& other) : ptr_(other.ptr_) {
+    if (ptr_) {
+      IntrusivePtrAddRef(ptr_);
+    }
+  }
+
+  // copy-and-swap：先拷贝 (计数 +1) 再交换，自赋值也安全
+  IntrusivePtr& operator=(const IntrusivePtr& other) {
+    IntrusivePtr(other).Swap(*this);
+    return *this;
+  }
+
+  // 移动：计数不变
+  IntrusivePtr(IntrusivePtr&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+
+  IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+    IntrusivePtr(std::move(other)).Swap(*this);
+    return *this;
+  }
+
+  void Reset(T* ptr = nullptr) { IntrusivePtr(ptr).Swap(*this); }
+
+  void Swap(IntrusivePtr& other) noexcept { std::swap(ptr_, other.ptr_); }
+
+  T* Get() const { return ptr_; }
+  T& operator*() const { return *ptr_; }
+  T* operator->() const { return ptr_; }
+  explicit operator bool() const { return ptr_ != nullptr; }
+
+  int UseCount() const { return ptr_ ? ptr_->RefCount() : 0; }
+
+private:
+  T* ptr_;
+};
+
+// 用法类似 std::make_shared，但只有一次分配 (计数本来就在对象里)
+template <typename T, typename... Args>
+IntrusivePtr<T> MakeIntrusive(Args&&... args) {
+  return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+#endif  // Week03_SHAREDPTR_INCLUDE_INTRUSIVE_PTR_HPP_
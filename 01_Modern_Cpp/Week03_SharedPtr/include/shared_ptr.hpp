@@ -1,48 +1,186 @@
 #ifndef Week03_SHAREDPTR_INCLUDE_SHARED_PTR_HPP_
 #define Week03_SHAREDPTR_INCLUDE_SHARED_PTR_HPP_
 
+#include <atomic>
+#include <memory> // std::allocator, std::allocator_traits
+#include <new>
+#include <utility>
+
+// ------------------------- 控制块 (Control Block) -------------------------
+// 所有 SharedPtr<T> / WeakPtr<T> 共用同一个非模板的控制块基类：两个计数器 + 两个"怎么销毁"的函数指针。
+// 具体怎么销毁 (delete 裸指针？原地析构？用哪个分配器释放？) 由创建它的地方决定，
+// 之后 SharedPtr 只管调用函数指针，不需要知道控制块的具体类型 (类型擦除，没有虚函数表)。
+//
+// 两个计数，两段生命周期：
+//   - strong：SharedPtr 的个数。归零时销毁对象 (dispose)
+//   - weak  ：WeakPtr 的个数 + 1 (所有 SharedPtr 合起来算一个)。归零时释放控制块 (deallocate)
+// 对象死了以后控制块还得活着：WeakPtr 要靠它回答"对象还在吗？"(Expired / Lock)
+struct ControlBlock {
+  using DisposeFn = void (*)(ControlBlock*);
+  using DeallocateFn = void (*)(ControlBlock*);
+
+  ControlBlock(void* object_ptr, DisposeFn dispose_fn, DeallocateFn deallocate_fn)
+      : object(object_ptr), dispose(dispose_fn), deallocate(deallocate_fn) {}
+
+  // 计数 +count：relaxed 就够了。
+  // 能拷贝说明手里已经有一个引用，对象 (或控制块) 不可能在这期间被销毁；这里也不需要和其他内存操作排序
+  // (一次加多个是给 AtomicSharedPtr 预付引用用的)
+  void AddStrong(int count = 1) { strong.fetch_add(count, std::memory_order_relaxed); }
+  void AddWeak() { weak.fetch_add(1, std::memory_order_relaxed); }
+
+  // 计数 -1，归零时销毁对象。必须是 acq_rel (与 std::shared_ptr 相同)：
+  //   - release：我之前对对象的所有写入，在别人看到计数减少之前完成
+  //   - acquire：最后一个人销毁之前，能看到其他线程对对象的所有写入
+  // 注意：必须用 fetch_sub 的返回值判断，不能先 -- 再读 (两步之间别的线程可能也减了，导致 double free)
+  void ReleaseStrong(int count = 1) {
+    if (strong.fetch_sub(count, std::memory_order_acq_rel) == count) {
+      // 我是最后一个 SharedPtr，负责清理对象。然后代表"所有 SharedPtr"放掉那一个弱引用
+      dispose(this);
+      ReleaseWeak();
+    }
+  }
+
+  void ReleaseWeak() {
+    if (weak.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      deallocate(this);
+    }
+  }
+
+  // WeakPtr::Lock 的核心：只有 strong 还没归零时才 +1。
+  // 不能直接 fetch_add：对象可能已经 (或正在被) 销毁，计数从 0 "复活"到 1 就是 use-after-free。
+  // 所以用 CAS 循环：读到 0 就放弃，否则尝试 count -> count + 1，期间被别人改了就重试
+  bool TryAddStrong() {
+    int count = strong.load(std::memory_order_relaxed);
+    while (count != 0) {
+      if (strong.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // 原子类型：多个线程同时拷贝 / 销毁指向同一个对象的 SharedPtr / WeakPtr 不再是数据竞争
+  std::atomic<int> strong{1};
+  std::atomic<int> weak{1};
+
+  // 被管理对象的地址 (类型擦除)。只知道控制块的地方 (AtomicSharedPtr) 靠它找回对象
+  void* object;
+
+  DisposeFn dispose;        // strong 归零时调用：销毁对象
+  DeallocateFn deallocate;  // weak 归零时调用：释放控制块本身
+};
+
+// SharedPtr(new T)：对象是用户 new 出来的，控制块另外分配 (两次分配)
+template <typename T>
+struct PointerControlBlock : ControlBlock {
+  explicit PointerControlBlock(T* object) : ControlBlock(object, &Dispose, &Deallocate), ptr(object) {}
+
+  static void Dispose(ControlBlock* block) {
+    delete static_cast<PointerControlBlock*>(block)->ptr;  // 杀掉对象 (打印 Ball Destroyed)
+  }
+
+  static void Deallocate(ControlBlock* block) {
+    delete static_cast<PointerControlBlock*>(block);  // 杀掉控制块
+  }
+
+  T* ptr;
+};
+
+// MakeShared：对象直接放在控制块后面，一次分配。计数和对象挨在一起，通常在同一条 cache line 上
+// 代价：对象析构以后，它占的内存要等最后一个 WeakPtr 也放手，才随控制块一起释放
+template <typename T>
+struct InplaceControlBlock : ControlBlock {
+  InplaceControlBlock() : ControlBlock(storage, &Dispose, &Deallocate) {}
+
+  T* Object() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+  static void Dispose(ControlBlock* block) {
+    // 对象是 placement new 出来的，只析构，不 delete
+    static_cast<InplaceControlBlock*>(block)->Object()->~T();
+  }
+
+  static void Deallocate(ControlBlock* block) {
+    delete static_cast<InplaceControlBlock*>(block);  // 对象的内存和计数器一起释放
+  }
+
+  alignas(T) unsigned char storage[sizeof(T)];
+};
+
+// AllocateShared：同样一次分配，但内存来自用户的分配器 (内存池、arena ...)
+// 分配器被 rebind 成"分配整个控制块"的版本，并保存在控制块里，归零时用它释放
+template <typename T, typename Alloc>
+struct AllocatorControlBlock : ControlBlock {
+  using BlockAlloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<AllocatorControlBlock>;
+  using ObjectAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+  explicit AllocatorControlBlock(const Alloc& allocator)
+      : ControlBlock(storage, &Dispose, &Deallocate), alloc(allocator) {}
+
+  T* Object() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+  static void Dispose(ControlBlock* block) {
+    auto* self = static_cast<AllocatorControlBlock*>(block);
+    ObjectAlloc object_alloc(self->alloc);
+    std::allocator_traits<ObjectAlloc>::destroy(object_alloc, self->Object());
+  }
+
+  static void Deallocate(ControlBlock* block) {
+    auto* self = static_cast<AllocatorControlBlock*>(block);
+    // 先把分配器拷出来：控制块析构之后 self->alloc 就不能再用了
+    BlockAlloc block_alloc(self->alloc);
+    std::allocator_traits<BlockAlloc>::destroy(block_alloc, self);
+    std::allocator_traits<BlockAlloc>::deallocate(block_alloc, self, 1);
+  }
+
+  [[no_unique_address]] BlockAlloc alloc;
+  alignas(T) unsigned char storage[sizeof(T)];
+};
+
+template <typename T>
+class SharedPtr;
+
+template <typename T>
+class WeakPtr;
+
+template <typename T>
+class AtomicSharedPtr;
+
+template <typename T, typename... Args>
+SharedPtr<T> MakeShared(Args&&... args);
+
+template <typename T, typename Alloc, typename... Args>
+SharedPtr<T> AllocateShared(const Alloc& alloc, Args&&... args);
+
 template <typename T>
 class SharedPtr {
  public:
   // 1. Default Constructor
-  SharedPtr() : ptr_(nullptr), ref_count_(nullptr) {}
+  SharedPtr() : ptr_(nullptr), control_(nullptr) {}
 
   // 2. Parameterized Constructor
-  explicit SharedPtr(T* ptr) : ptr_(ptr), ref_count_(nullptr) {
+  explicit SharedPtr(T* ptr) : ptr_(ptr), control_(nullptr) {
     if (ptr) {
-      // new int(1): 申请一个 int 大小的堆内存，并初始化值为 1
-      // 不要用 new int[1]，那是数组！后续必须用 delete[] 释放。但引用计数通常只是一个 int，不是数组。
-        ref_count_ = new int(1);
+      // 控制块单独 new 一次 (计数初始化为 1)。想省掉这次分配，请用 MakeShared
+      control_ = new PointerControlBlock<T>(ptr);
     }
-    // 如果 ptr 是 nullptr，ref_count_ 保持 nullptr (初始化列表里已做)
+    // 如果 ptr 是 nullptr，control_ 保持 nullptr (初始化列表里已做)
   }
 
   // 3. Destructor
   ~SharedPtr() {
-    // 只有当引用计数器存在时，才需要处理
-    // (如果是空指针 SharedPtr()，ref_count_ 是 nullptr，直接跳过)
-    if (ptr_ && ref_count_) {
-      // 1. 计数减一
-      (*ref_count_)--;
-
-      // 2. 检查是否归零
-      if (*ref_count_ == 0) {
-        // 3. 我是最后一个，负责清理现场
-        // std::cout << "[Destructor] Ref count is 0. Freeing memory..." << std::endl; // Debug用
-        delete ptr_;       // 杀掉对象 (打印 Ball Destroyed)
-        delete ref_count_; // 杀掉计数器
-      }
-    }
+    // 只有当控制块存在时，才需要处理
+    // (如果是空指针 SharedPtr()，control_ 是 nullptr，直接跳过)
+    Release();
   }
 
   // 4. Copy Constructor
   SharedPtr(const SharedPtr& other) {
     ptr_ = other.ptr_;
-    ref_count_ = other.ref_count_;
+    control_ = other.control_;
     // 只有当对方不是空指针时，才增加计数
-    if (ref_count_) {
-      (*ref_count_)++;
-    }
+    AddRef();
   }
 
   // 5. Copy Assignment Operator
@@ -55,23 +193,14 @@ class SharedPtr {
 
     // 2. 释放旧资源 (Release old resource)
     // 这段逻辑和析构函数完全一样！
-    if (ref_count_) { 
-      (*ref_count_)--;
-      if (*ref_count_ == 0) {
-        delete ptr_;
-        delete ref_count_;
-        std::cout << "Old resource destroyed" << std::endl;
-      }
-    }
+    Release();
 
     // 3. 接管新资源 (Acquire new resource)
     ptr_ = other.ptr_;
-    ref_count_ = other.ref_count_;
+    control_ = other.control_;
 
     // 4. 增加新计数 (Increment new ref count)
-    if (ref_count_) {
-      (*ref_count_)++;
-    }
+    AddRef();
 
     return *this;
   }
@@ -80,59 +209,216 @@ class SharedPtr {
   SharedPtr(SharedPtr&& other) noexcept {
     // 1. Steal (偷)
     ptr_ = other.ptr_;
-    ref_count_ = other.ref_count_;
-    
+    control_ = other.control_;
+
     // 2. Reset (擦除对方记忆) -> 关键！
     other.ptr_ = nullptr;
-    other.ref_count_ = nullptr;
+    other.control_ = nullptr;
   }
 
   // 7. Move Assignment Operator
   SharedPtr& operator=(SharedPtr&& other) noexcept {
     if (this == &other) return *this;
 
-    // 1. Release old resources 
-    if (ref_count_) {
-      (*ref_count_)--;
-      if (*ref_count_ == 0) {
-        delete ptr_;
-        delete ref_count_;
-      }
-    }
+    // 1. Release old resources
+    Release();
 
     // 2. Steal (偷)
     ptr_ = other.ptr_;
-    ref_count_ = other.ref_count_;
-    
+    control_ = other.control_;
+
     // 3. Reset (擦除对方记忆) -> 关键！
     other.ptr_ = nullptr;
-    other.ref_count_ = nullptr;
-    
+    other.control_ = nullptr;
+
     return *this;
   }
 
   // Helper: Get current reference count
+  // 多线程下只是一个瞬时值 (读完的下一刻就可能被别的线程改掉)，只用于调试 / 测试
   int UseCount() const {
     // 安全检查
-    // 如果 ref_count_ 存在，解引用它；否则返回 0
-    if (ref_count_) {
-      return *ref_count_;
+    // 如果 control_ 存在，读它的计数；否则返回 0
+    if (control_) {
+      return control_->strong.load(std::memory_order_relaxed);
     }
     return 0;
   }
-  
+
   // Helper: Get raw pointer
-  T* Get() const { 
-      return ptr_; 
+  T* Get() const {
+      return ptr_;
+  }
+
+  T& operator*() const {
+    return *ptr_;
   }
 
   T* operator->() const {
     return ptr_;
   }
 
+  explicit operator bool() const {
+    return ptr_ != nullptr;
+  }
+
  private:
+  friend class WeakPtr<T>;
+  friend class AtomicSharedPtr<T>;
+
+  template <typename U, typename... Args>
+  friend SharedPtr<U> MakeShared(Args&&... args);
+
+  template <typename U, typename Alloc, typename... Args>
+  friend SharedPtr<U> AllocateShared(const Alloc& alloc, Args&&... args);
+
+  // 给 MakeShared / AllocateShared / WeakPtr::Lock 用：控制块已经建好，这份强引用已经计过数了
+  SharedPtr(T* ptr, ControlBlock* control) : ptr_(ptr), control_(control) {}
+
+  // 计数的内存序见 ControlBlock
+  void AddRef() {
+    if (control_) {
+      control_->AddStrong();
+    }
+  }
+
+  void Release() {
+    if (control_) {
+      // 具体怎么销毁由控制块自己决定
+      control_->ReleaseStrong();
+    }
+  }
+
   T* ptr_;
-  int* ref_count_; // The Control Block ------ 指向引用计数的指针 (int*)
+  // The Control Block ------ 强 / 弱计数器 + 销毁方式。
+  // ptr_ 单独存一份，解引用时不用先跳到控制块里找对象
+  ControlBlock* control_;
+};
+
+// ------------------------- WeakPtr -------------------------
+// 弱引用：指向对象，但不让对象续命 (不增加 strong，只增加 weak)。
+// 用来打破循环引用，或者做缓存 / 连接注册表：表里记着对象，但对象该死的时候照样死。
+// 不能直接解引用 (对象随时可能已经死了)，必须先 Lock() 换成 SharedPtr：
+//   if (SharedPtr<Conn> conn = weak.Lock()) { conn->Send(...); }  // 拿到了就保证在作用域内一直活着
+template <typename T>
+class WeakPtr {
+ public:
+  WeakPtr() : ptr_(nullptr), control_(nullptr) {}
+
+  // 从 SharedPtr 构造：weak +1，strong 不变
+  WeakPtr(const SharedPtr<T>& shared) : ptr_(shared.ptr_), control_(shared.control_) {
+    AddRef();
+  }
+
+  ~WeakPtr() { Release(); }
+
+  WeakPtr(const WeakPtr& other) : ptr_(other.ptr_), control_(other.control_) { AddRef(); }
+
+  WeakPtr& operator=(const WeakPtr& other) {
+    // 先加后减：即使 other 和自己指向同一个控制块 (包括自赋值)，控制块也不会在中途被释放
+    if (other.control_) {
+      other.control_->AddWeak();
+    }
+    Release();
+    ptr_ = other.ptr_;
+    control_ = other.control_;
+    return *this;
+  }
+
+  WeakPtr(WeakPtr&& other) noexcept
+      : ptr_(std::exchange(other.ptr_, nullptr)), control_(std::exchange(other.control_, nullptr)) {}
+
+  WeakPtr& operator=(WeakPtr&& other) noexcept {
+    if (this == &other) return *this;
+    Release();
+    ptr_ = std::exchange(other.ptr_, nullptr);
+    control_ = std::exchange(other.control_, nullptr);
+    return *this;
+  }
+
+  WeakPtr& operator=(const SharedPtr<T>& shared) { return *this = WeakPtr(shared); }
+
+  // 对象还活着就返回一个新的强引用，否则返回空。
+  // 原子的"检查 + 加一"(CAS 循环)：不会出现"检查时还活着，加一之前被别的线程销毁"的情况
+  SharedPtr<T> Lock() const {
+    if (control_ && control_->TryAddStrong()) {
+      return SharedPtr<T>(ptr_, control_);
+    }
+    return SharedPtr<T>();
+  }
+
+  // 对象是否已经销毁。多线程下 false 只是瞬时结论 (下一刻就可能变成 true)，要用对象请直接 Lock()
+  bool Expired() const { return UseCount() == 0; }
+
+  // 当前的强引用个数
+  int UseCount() const {
+    return control_ ? control_->strong.load(std::memory_order_relaxed) : 0;
+  }
+
+  void Reset() {
+    Release();
+    ptr_ = nullptr;
+    control_ = nullptr;
+  }
+
+ private:
+  void AddRef() {
+    if (control_) {
+      control_->AddWeak();
+    }
+  }
+
+  void Release() {
+    if (control_) {
+      control_->ReleaseWeak();
+    }
+  }
+
+  T* ptr_;                 // 对象死后依然保留这个地址，但绝不解引用 (只在 Lock 成功时交给 SharedPtr)
+  ControlBlock* control_;
 };
 
-#endif  // Week03_SHAREDPTR_INCLUDE_SHARED_PTR_HPP_
\ No newline at end of file
+// ------------------------- MakeShared / AllocateShared -------------------------
+// SharedPtr<Ball>(new Ball()) 需要两次分配：new Ball + new 控制块。
+// MakeShared 把控制块和对象放进同一块内存：
+//   [ strong | weak | object | dispose | deallocate | Ball 对象 ... ]
+// 分配次数减半，而且拷贝时改的计数和对象本身挨在一起 (cache 友好)。
+template <typename T, typename... Args>
+SharedPtr<T> MakeShared(Args&&... args) {
+  auto* block = new InplaceControlBlock<T>();
+  T* object;
+  try {
+    object = ::new (static_cast<void*>(block->storage)) T(std::forward<Args>(args)...);
+  } catch (...) {
+    delete block;  // 构造函数抛异常：对象没构造出来，只释放内存
+    throw;
+  }
+  return SharedPtr<T>(object, block);
+}
+
+// 分配器版本：控制块 + 对象的那一整块内存由 alloc 提供 (例如内存池)
+template <typename T, typename Alloc, typename... Args>
+SharedPtr<T> AllocateShared(const Alloc& alloc, Args&&... args) {
+  using Block = AllocatorControlBlock<T, Alloc>;
+  typename Block::BlockAlloc block_alloc(alloc);
+  Block* block = std::allocator_traits<typename Block::BlockAlloc>::allocate(block_alloc, 1);
+  try {
+    std::allocator_traits<typename Block::BlockAlloc>::construct(block_alloc, block, alloc);
+  } catch (...) {
+    std::allocator_traits<typename Block::BlockAlloc>::deallocate(block_alloc, block, 1);
+    throw;
+  }
+
+  typename Block::ObjectAlloc object_alloc(alloc);
+  try {
+    std::allocator_traits<typename Block::ObjectAlloc>::construct(
+        object_alloc, reinterpret_cast<T*>(block->storage), std::forward<Args>(args)...);
+  } catch (...) {
+    std::allocator_traits<typename Block::BlockAlloc>::destroy(block_alloc, block);
+    std::allocator_traits<typename Block::BlockAlloc>::deallocate(block_alloc, block, 1);
+    throw;
+  }
+  return SharedPtr<T>(block->Object(), block);
+}
+
+#endif  // Week03_SHAREDPTR_INCLUDE_SHARED_PTR_HPP_
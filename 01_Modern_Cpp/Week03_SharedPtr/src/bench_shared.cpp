@@ -0,0 +1,77 @@
+// src/bench_shared.cpp
+// 拷贝开销：SharedPtr (原子计数) vs std::shared_ptr
+// 创建开销：SharedPtr(new T) (两次分配) vs MakeShared (一次分配) vs std::make_shared
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "shared_ptr.hpp"
+
+struct Payload {
+  int value = 1;
+};
+
+const int kCopies = 10000000;
+
+// 每个线程反复 拷贝 + 销毁 同一个指针 (所有线程改的是同一个计数器，cache line 会在核之间来回跳)
+template <typename Ptr>
+void Run(const char* name, const Ptr& shared, int num_threads) {
+  std::vector<long long> sinks(num_threads);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t] {
+      long long sum = 0;
+      for (int i = 0; i < kCopies; ++i) {
+        Ptr copy(shared);
+        sum += copy->value;
+      }
+      sinks[t] = sum;
+    });
+  }
+  for (auto& th : threads) th.join();
+  auto end = std::chrono::steady_clock::now();
+
+  long long sink = 0;
+  for (long long s : sinks) sink += s;
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / kCopies;
+  std::cout << "  " << name << " threads=" << num_threads << ": " << ns
+            << " ns per copy+destroy (per thread)  (sink=" << sink << ")" << std::endl;
+}
+
+// 每次创建 + 销毁一个对象
+template <typename MakeFn>
+void RunCreate(const char* name, MakeFn make) {
+  const int kCreates = 5000000;
+  long long sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCreates; ++i) {
+    auto ptr = make();
+    sum += ptr->value;
+  }
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / kCreates;
+  std::cout << "  " << name << ": " << ns << " ns per create+destroy  (sink=" << sum << ")" << std::endl;
+}
+
+int main() {
+  std::cout << "=== SharedPtr Copy Benchmark ===" << std::endl;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  SharedPtr<Payload> mine(new Payload());
+  std::shared_ptr<Payload> standard = std::make_shared<Payload>();
+
+  for (int threads : {1, 4}) {
+    Run("SharedPtr      ", mine, threads);
+    Run("std::shared_ptr", standard, threads);
+  }
+
+  std::cout << "--- create + destroy ---" << std::endl;
+  RunCreate("SharedPtr(new T)     ", [] { return SharedPtr<Payload>(new Payload()); });
+  RunCreate("MakeShared<T>        ", [] { return MakeShared<Payload>(); });
+  RunCreate("std::make_shared<T>  ", [] { return std::make_shared<Payload>(); });
+  return 0;
+}
@@ -0,0 +1,93 @@
+// src/test_atomic_shared.cpp
+// 多线程压力测试：一个 AtomicSharedPtr 被很多线程同时 Load / Store / CompareExchange
+// 检查三件事：读到的快照是完整的 (不会读到半新半旧)、CAS 不丢更新、每个对象恰好析构一次
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "atomic_shared_ptr.hpp"
+
+std::atomic<int> g_created{0};
+std::atomic<int> g_destroyed{0};
+
+// 一份"配置"快照：构造后不再修改，second 永远等于 first 的两倍
+class Config {
+public:
+  explicit Config(long long version) : version_(version), doubled_(version * 2) { g_created.fetch_add(1); }
+  ~Config() { g_destroyed.fetch_add(1); }
+
+  long long version() const { return version_; }
+  bool Consistent() const { return doubled_ == version_ * 2; }
+
+private:
+  long long version_;
+  long long doubled_;
+};
+
+const int kReaders = 4;
+const int kWriters = 2;
+const int kIterations = 100000;
+
+int main() {
+  std::cout << "--- Test 9: AtomicSharedPtr ---" << std::endl;
+  std::cout << "lock-free: " << std::boolalpha << AtomicSharedPtr<Config>::kIsAlwaysLockFree << std::endl;
+  bool ok = true;
+
+  {
+    AtomicSharedPtr<Config> current(MakeShared<Config>(0));
+
+    // 1. 读者反复 Load，写者反复 Store 新快照
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kReaders; ++t) {
+      threads.emplace_back([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+          SharedPtr<Config> snapshot = current.Load();
+          if (!snapshot->Consistent()) std::abort();
+        }
+      });
+    }
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kWriters; ++t) {
+      writers.emplace_back([&, t] {
+        for (int i = 1; i <= kIterations; ++i) {
+          current.Store(MakeShared<Config>(i * kWriters + t));
+        }
+      });
+    }
+    for (auto& th : writers) th.join();
+    done = true;
+    for (auto& th : threads) th.join();
+
+    // 2. CompareExchange 做"读-改-写"：每个线程给版本号加 kIterations 次，一次都不能丢
+    current.Store(MakeShared<Config>(0));
+    threads.clear();
+    for (int t = 0; t < kReaders; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < kIterations; ++i) {
+          SharedPtr<Config> expected = current.Load();
+          while (!current.CompareExchange(expected, MakeShared<Config>(expected->version() + 1))) {
+          }
+        }
+      });
+    }
+    for (auto& th : threads) th.join();
+
+    long long final_version = current.Load()->version();
+    std::cout << "version after " << kReaders << " x " << kIterations << " CAS increments: " << final_version
+              << std::endl;  // Expect: 400000
+    ok = ok && final_version == static_cast<long long>(kReaders) * kIterations;
+
+    // 3. Exchange 返回旧值，旧值由调用者接管
+    SharedPtr<Config> previous = current.Exchange(SharedPtr<Config>());
+    ok = ok && previous && previous->version() == final_version && !current.Load();
+  }
+
+  std::cout << "Created " << g_created.load() << ", destroyed " << g_destroyed.load() << std::endl;  // Expect: equal
+  ok = ok && g_created.load() == g_destroyed.load();
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -22,6 +22,25 @@ public:
   SharedPtr<Man> boyfriend;
 };
 
+// 修复版：一方改成 WeakPtr，环里只剩一条强引用
+class Wife;
+
+class Husband {
+public:
+  Husband() { std::cout << "  Husband Created" << std::endl; }
+  ~Husband() { std::cout << "  Husband Destroyed" << std::endl; }
+
+  SharedPtr<Wife> wife;   // 强引用：Husband 让 Wife 活着
+};
+
+class Wife {
+public:
+  Wife() { std::cout << "  Wife Created" << std::endl; }
+  ~Wife() { std::cout << "  Wife Destroyed" << std::endl; }
+
+  WeakPtr<Husband> husband;  // 弱引用：只"认识"Husband，不让他续命
+};
+
 int main() {
   std::cout << "--- Test 4: Circular Dependency (The Trap) ---" << std::endl;
 
@@ -109,6 +128,34 @@ int main() {
      所以 boyfriend 继续抓着 Man。
   */
 
+  std::cout << "--- Test 8: Breaking the Cycle with WeakPtr ---" << std::endl;
+
+  WeakPtr<Husband> observer;  // 活得比两个人都久的观察者 (比如连接注册表里的一项)
+  {
+    SharedPtr<Husband> h = MakeShared<Husband>();
+    SharedPtr<Wife> w = MakeShared<Wife>();
+
+    h->wife = w;        // Wife 计数 2
+    w->husband = h;     // Husband 计数仍然是 1 (弱引用不计入)
+    observer = h;
+
+    std::cout << "Linked - h UseCount: " << h.UseCount() << std::endl;  // Expect: 1
+    std::cout << "Linked - w UseCount: " << w.UseCount() << std::endl;  // Expect: 2
+
+    // 通过弱引用访问对方：先 Lock 成强引用
+    if (SharedPtr<Husband> locked = w->husband.Lock()) {
+      std::cout << "Wife can reach Husband, UseCount while locked: " << locked.UseCount() << std::endl;  // Expect: 2
+    }
+
+    std::cout << "Exiting scope..." << std::endl;
+  }
+  // 预期：Husband Destroyed, Wife Destroyed
+  // w 先离开作用域 (后声明的先析构) -> Wife 计数 2 -> 1
+  // h 离开作用域 -> Husband 计数 1 -> 0，Husband 析构，顺带释放他手里的 wife -> Wife 计数 1 -> 0，Wife 析构
+
+  std::cout << "observer Expired: " << std::boolalpha << observer.Expired() << std::endl;  // Expect: true
+  std::cout << "observer Lock() is null: " << !observer.Lock() << std::endl;                 // Expect: true
+
   std::cout << "--- End of Test ---" << std::endl;
   return 0;
 }
@@ -0,0 +1,89 @@
+// src/test_concurrency.cpp
+// 多线程压力测试：很多线程同时拷贝 / 销毁指向同一个对象的 SharedPtr
+// 计数器如果不是原子的，++/-- 会丢失更新：要么对象被提前释放 (use-after-free)，要么永远不释放 (泄漏)
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "shared_ptr.hpp"
+
+std::atomic<int> g_destroyed{0};
+
+class Payload {
+public:
+  ~Payload() { g_destroyed.fetch_add(1); }
+  int value = 42;
+};
+
+const int kThreads = 8;
+const int kIterations = 200000;
+
+int main() {
+  std::cout << "--- Test 6: Concurrent Copy / Destroy ---" << std::endl;
+  bool ok = true;
+
+  // 1. 所有线程反复拷贝同一个 SharedPtr，结束后计数必须回到 1，对象还活着
+  {
+    SharedPtr<Payload> shared(new Payload());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&shared] {
+        for (int i = 0; i < kIterations; ++i) {
+          SharedPtr<Payload> copy(shared);      // +1
+          SharedPtr<Payload> another;
+          another = copy;                        // +1
+          if (another->value != 42) std::abort();
+        }                                        // -2
+      });
+    }
+    for (auto& th : threads) th.join();
+
+    std::cout << "UseCount after " << kThreads << " threads: " << shared.UseCount() << std::endl;  // Expect: 1
+    ok = ok && shared.UseCount() == 1 && g_destroyed.load() == 0;
+  }
+  ok = ok && g_destroyed.load() == 1;
+
+  // 2. 每个线程拿一份拷贝，和主线程同时放手：无论谁最后放手，对象都恰好销毁一次
+  const int kRounds = 2000;
+  g_destroyed = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    std::vector<std::thread> threads;
+    {
+      SharedPtr<Payload> shared(new Payload());
+      for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([copy = shared]() mutable {
+          SharedPtr<Payload> local = std::move(copy);
+        });
+      }
+    }  // 主线程的引用在这里释放，可能早于也可能晚于工作线程
+    for (auto& th : threads) th.join();
+  }
+  std::cout << "Destroyed " << g_destroyed.load() << " / " << kRounds << " objects" << std::endl;  // Expect: 2000 / 2000
+  ok = ok && g_destroyed.load() == kRounds;
+
+  // 3. WeakPtr::Lock 与最后一个 SharedPtr 的释放同时发生：
+  //    Lock 要么拿到一个完整活着的对象，要么拿到空，绝不能"复活"已经开始析构的对象
+  g_destroyed = 0;
+  int locked = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    SharedPtr<Payload> shared = MakeShared<Payload>();
+    WeakPtr<Payload> weak(shared);
+    std::thread locker([weak, &locked] {
+      if (SharedPtr<Payload> strong = weak.Lock()) {
+        if (strong->value != 42) std::abort();
+        ++locked;
+      }
+    });
+    shared = SharedPtr<Payload>();  // 与 Lock 赛跑
+    locker.join();
+    ok = ok && weak.Expired();
+  }
+  std::cout << "Lock raced with release: " << locked << " / " << kRounds << " locks succeeded, "
+            << g_destroyed.load() << " destroyed" << std::endl;  // Expect: x / 2000, 2000 destroyed
+  ok = ok && g_destroyed.load() == kRounds;
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// src/test_intrusive.cpp
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "intrusive_ptr.hpp"
+#include "shared_ptr.hpp"
+
+// 跨线程共享的连接：原子计数
+class Connection final : public RefCounted<Connection> {
+public:
+  explicit Connection(int fd) : fd_(fd) { std::cout << "  Connection " << fd_ << " Created" << std::endl; }
+  ~Connection() { std::cout << "  Connection " << fd_ << " Destroyed" << std::endl; }
+
+  // 计数就在对象里，所以可以直接从 this 造一个新的 IntrusivePtr (SharedPtr 这样做会 double free)
+  IntrusivePtr<Connection> Self() { return IntrusivePtr<Connection>(this); }
+
+  int fd() const { return fd_; }
+
+private:
+  int fd_;
+};
+
+// 只在一个线程里用的缓冲区：非原子计数，拷贝就是一条普通的 ++
+class Buffer final : public RefCounted<Buffer, NonAtomicRefCount> {
+public:
+  char data[64] = {};
+};
+
+// 会被继承的计数类型：计数归零时 delete 的是 Session*，析构函数必须是虚的
+// (去掉 virtual 或者 final 都没有的话，IntrusivePtrRelease 里的 static_assert 会让编译失败)
+class Session : public RefCounted<Session> {
+public:
+  virtual ~Session() { std::cout << "  Session Destroyed" << std::endl; }
+};
+
+class TlsSession final : public Session {
+public:
+  ~TlsSession() override { std::cout << "  TlsSession Destroyed" << std::endl; }
+};
+
+int main() {
+  std::cout << "--- Test 5: IntrusivePtr ---" << std::endl;
+
+  // 1. 大小：只有一个指针。SharedPtr 是两个指针 (对象 + 控制块)
+  std::cout << "sizeof(IntrusivePtr<Connection>): " << sizeof(IntrusivePtr<Connection>)
+            << ", sizeof(SharedPtr<Connection>): " << sizeof(SharedPtr<Connection>) << std::endl;
+
+  {
+    // 2. 一次分配：计数器在 Connection 对象内部
+    IntrusivePtr<Connection> conn = MakeIntrusive<Connection>(7);
+    std::cout << "conn UseCount: " << conn.UseCount() << std::endl;  // Expect: 1
+
+    // 3. 从 this 重新构造：计数正确累加，不会 double free
+    IntrusivePtr<Connection> self = conn->Self();
+    std::cout << "after Self() UseCount: " << conn.UseCount() << std::endl;  // Expect: 2
+
+    // 4. 多个线程同时拷贝 / 销毁 (原子计数)
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+      workers.emplace_back([conn] {
+        for (int i = 0; i < 100000; ++i) {
+          IntrusivePtr<Connection> copy = conn;
+        }
+      });
+    }
+    for (auto& worker : workers) worker.join();
+    std::cout << "after threads UseCount: " << conn.UseCount() << std::endl;  // Expect: 2
+
+    // 5. 非原子计数的对象
+    IntrusivePtr<Buffer> buffer = MakeIntrusive<Buffer>();
+    IntrusivePtr<Buffer> alias = buffer;
+    std::cout << "buffer UseCount: " << buffer.UseCount() << std::endl;  // Expect: 2
+
+    std::cout << "Exiting scope..." << std::endl;
+  }  // Expect: Connection 7 Destroyed
+
+  // 6. 继承体系：IntrusivePtr<TlsSession> 释放时走的是 IntrusivePtrRelease(const Session*)，
+  //    靠虚析构函数才能把 TlsSession 部分也析构掉
+  {
+    IntrusivePtr<TlsSession> tls = MakeIntrusive<TlsSession>();
+    IntrusivePtr<Session> base(tls.Get());
+    std::cout << "tls UseCount: " << tls.UseCount() << std::endl;  // Expect: 2
+  }  // Expect: TlsSession Destroyed, Session Destroyed
+
+  std::cout << "--- End of Test ---" << std::endl;
+  return 0;
+}
@@ -0,0 +1,98 @@
+// src/test_make_shared.cpp
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#include "shared_ptr.hpp"
+
+// Ball 自己单独分配了几次 (类专属的 operator new，只管 new Ball，不碰全局 new / delete)
+int g_ball_allocations = 0;
+
+class Ball {
+public:
+  explicit Ball(int id) : id_(id) { std::cout << "  Ball " << id_ << " Created" << std::endl; }
+  ~Ball() { std::cout << "  Ball " << id_ << " Destroyed" << std::endl; }
+  int id() const { return id_; }
+
+  static void* operator new(std::size_t size) {
+    ++g_ball_allocations;
+    return ::operator new(size);
+  }
+  static void operator delete(void* p) { ::operator delete(p); }
+
+private:
+  int id_;
+};
+
+// 分配器每次分配的记录：次数 + 最近一块内存的范围 (用来确认对象就在这块内存里)
+struct AllocationLog {
+  int count = 0;
+  const char* last_begin = nullptr;
+  const char* last_end = nullptr;
+
+  bool Contains(const void* p) const {
+    const char* c = static_cast<const char*>(p);
+    return c >= last_begin && c < last_end;
+  }
+};
+
+// 一个最简单的自定义分配器：转发给 malloc，并记录自己分配了多少次
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator(AllocationLog* allocation_log) : log(allocation_log) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>& other) : log(other.log) {}
+
+  T* allocate(std::size_t n) {
+    void* p = std::malloc(n * sizeof(T));
+    if (p == nullptr) throw std::bad_alloc();
+    ++log->count;
+    log->last_begin = static_cast<const char*>(p);
+    log->last_end = log->last_begin + n * sizeof(T);
+    return static_cast<T*>(p);
+  }
+  void deallocate(T* p, std::size_t) { std::free(p); }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>& other) const { return log == other.log; }
+
+  AllocationLog* log;
+};
+
+int main() {
+  std::cout << "--- Test 7: MakeShared (Single Allocation) ---" << std::endl;
+
+  // SharedPtr(new Ball)：Ball 单独 new 一次，控制块再 new 一次
+  int before = g_ball_allocations;
+  {
+    SharedPtr<Ball> sp(new Ball(1));
+    std::cout << "SharedPtr(new Ball): " << g_ball_allocations - before
+              << " separate Ball allocation (+1 control block)" << std::endl;  // Expect: 1
+  }
+
+  // MakeShared：Ball 直接构造在控制块里，没有单独的分配
+  before = g_ball_allocations;
+  {
+    SharedPtr<Ball> sp = MakeShared<Ball>(2);
+    SharedPtr<Ball> copy = sp;
+    std::cout << "MakeShared<Ball>:    " << g_ball_allocations - before << " separate Ball allocations"
+              << ", UseCount: " << copy.UseCount() << std::endl;  // Expect: 0, 2
+  }
+
+  // AllocateShared：所有内存都经过分配器，一共只分配一次，Ball 就在那一块里
+  AllocationLog log;
+  before = g_ball_allocations;
+  {
+    SharedPtr<Ball> sp = AllocateShared<Ball>(CountingAllocator<Ball>(&log), 3);
+    std::cout << "AllocateShared<Ball>: " << log.count << " allocation from the custom allocator, "
+              << g_ball_allocations - before << " separate Ball allocations, Ball inside that block: "
+              << std::boolalpha << log.Contains(sp.Get()) << ", id = " << sp->id()
+              << std::endl;  // Expect: 1, 0, true
+  }
+
+  std::cout << "--- End of Test ---" << std::endl;
+  return 0;
+}
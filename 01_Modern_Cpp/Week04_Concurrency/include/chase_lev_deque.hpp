@@ -0,0 +1,137 @@
+#ifndef Week04_Concurrency_INCLUDE_CHASE_LEV_DEQUE_HPP
+#define Week04_Concurrency_INCLUDE_CHASE_LEV_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// 工作窃取双端队列 (Chase-Lev Deque, "Dynamic Circular Work-Stealing Deque", SPAA 2005；
+// 内存序按 Lê 等人 "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013)
+//
+// 一个主人 (owner) + 任意多个小偷 (thief)：
+//   - 主人在底部 (bottom_) Push / Pop，后进先出：刚拆出来的子任务马上接着跑，数据还热在缓存里
+//   - 小偷从顶部 (top_) Steal，先进先出：偷走的是最老的任务，通常也是最大的一块 (递归拆分时越早拆出来的越大)
+//   - 主人的 Push 没有任何 CAS；Pop 只有在抢最后一个元素时才和小偷 CAS 一次 top_；小偷之间靠 CAS top_ 决胜负
+//
+// 数组满了主人会换一个两倍大的。小偷可能还拿着旧数组的指针在读，所以旧数组不能马上释放：
+// 全部留到析构 (总共不超过最终大小的 2 倍)。
+//
+// 元素要能被小偷"先读出来、CAS 失败再扔掉"，所以只支持可平凡拷贝的类型 (一般放指针)。
+template <typename T>
+class ChaseLevDeque {
+  static_assert(std::is_trivially_copyable_v<T>, "ChaseLevDeque stores T in std::atomic; use a pointer");
+
+public:
+  static constexpr size_t kDefaultCapacity = 256;
+
+  explicit ChaseLevDeque(size_t capacity = kDefaultCapacity) {
+    int64_t size = 2;
+    while (static_cast<size_t>(size) < capacity) {
+      size <<= 1;
+    }
+    arrays_.push_back(std::make_unique<Array>(size));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  ChaseLevDeque(const ChaseLevDeque&) = delete;
+  ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+  // ---------------- 只有主人线程能调用 ----------------
+
+  void Push(T value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->mask) {
+      array = Grow(array, top, bottom);
+    }
+    array->Store(bottom, value);
+    // release：小偷看到新的 bottom_ 时，一定也看得到刚写进去的元素
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // 从底部取 (后进先出)。空了 (或者最后一个被小偷抢走了) 返回 false
+  bool Pop(T& value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    // 先占住 bottom 再看 top。两边都是 seq_cst：和 Steal 里"先读 top 再读 bottom"构成 Dekker 式的互斥，
+    // 不会出现主人和小偷都以为自己拿到了同一个元素 (只剩一个时交给下面的 CAS 决定)
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      // 本来就是空的
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    value = array->Load(bottom);
+    if (top == bottom) {
+      // 最后一个：和小偷抢，谁把 top_ 推过去算谁的
+      bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // ---------------- 任意线程 ----------------
+
+  // 从顶部偷 (先进先出)。空了，或者和别的小偷 / 主人抢输了，返回 false (调用方换个目标或者稍后再试)
+  bool Steal(T& value) {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return false;
+    }
+    Array* array = array_.load(std::memory_order_acquire);
+    T stolen = array->Load(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return false;
+    }
+    value = stolen;
+    return true;
+  }
+
+  // 瞬时值，只用于调试 / 统计
+  size_t size() const {
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    int64_t top = top_.load(std::memory_order_acquire);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+  }
+
+  bool Empty() const { return size() == 0; }
+
+private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Array {
+    explicit Array(int64_t size) : mask(size - 1), slots(new std::atomic<T>[size]) {}
+
+    // 槽位本身也是原子的：小偷读旧值的同时主人可能在写别的圈的值，用 relaxed 的原子读写避免数据竞争
+    T Load(int64_t index) const { return slots[index & mask].load(std::memory_order_relaxed); }
+    void Store(int64_t index, T value) { slots[index & mask].store(value, std::memory_order_relaxed); }
+
+    int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  Array* Grow(Array* old_array, int64_t top, int64_t bottom) {
+    arrays_.push_back(std::make_unique<Array>((old_array->mask + 1) * 2));
+    Array* array = arrays_.back().get();
+    for (int64_t i = top; i < bottom; ++i) {
+      array->Store(i, old_array->Load(i));
+    }
+    array_.store(array, std::memory_order_release);
+    return array;
+  }
+
+  // 小偷改 top_，主人改 bottom_：各占一条 cache line
+  alignas(kCacheLineSize) std::atomic<int64_t> top_{0};
+  alignas(kCacheLineSize) std::atomic<int64_t> bottom_{0};
+  std::atomic<Array*> array_{nullptr};
+  std::vector<std::unique_ptr<Array>> arrays_;  // 用过的所有数组 (只有主人会改)，析构时一起释放
+};
+
+#endif // Week04_Concurrency_INCLUDE_CHASE_LEV_DEQUE_HPP
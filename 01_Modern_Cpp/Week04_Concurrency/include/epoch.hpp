@@ -0,0 +1,296 @@
+#ifndef Week04_Concurrency_INCLUDE_EPOCH_HPP
+#define Week04_Concurrency_INCLUDE_EPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 基于纪元的内存回收 (Epoch-Based Reclamation, EBR)
+//
+// 无锁结构最难的不是"摘下节点"，而是"什么时候能 delete 它"：
+// 摘下的那一刻，别的线程可能刚读到这个节点的指针、正准备解引用。立刻 delete 就是 use-after-free。
+// ThreadSafeQueue 用一把 mutex 回避了这个问题 (持锁期间没人能读)，无锁结构没有这把锁。
+//
+// EBR 的思路：不追踪"谁在读哪个节点"，只追踪"谁在读"。
+//   1. 全局有一个纪元 (epoch) 计数器
+//   2. 读者访问共享结构前先 EpochGuard guard; —— 把"我在 e 纪元进场"登记到自己的线程记录里，出作用域离场
+//   3. 写者摘下节点后 Retire(node)：不立刻释放，挂到自己线程的待回收袋子里，标上当前纪元 e
+//   4. 只有当所有在场的读者都已经进入当前纪元时，全局纪元才能 +1
+//   5. 全局纪元到了 e + 2，e 纪元摘下的节点就可以安全释放了：
+//      能看到它的读者最晚在 e 纪元进场，而纪元能走到 e + 2，说明这些读者都已经离场过 (至少一次)
+//
+// 每个线程 3 个袋子 (e % 3)，轮流使用。每 Retire kCollectThreshold 个就尝试推进纪元并回收。
+//
+// 内存上界：读者在临界区里被抢占 (单核机器上一个时间片就是几毫秒) 时纪元推不动，写者的垃圾会一直攒。
+// 所以一个线程手里待回收的超过 kMaxLocalPending 个时，Retire 会让出 CPU、反复尝试回收，直到降回上界以下
+// (写者被读者反压，而不是内存无限涨)。例外：调用 Retire 时自己还在临界区里 (比如无锁栈的 Pop)，
+// 自己就挡着纪元，等下去会死锁，这时只能先攒着。
+// 某个读者卡在临界区里永远不出来 (睡眠、死循环)，写者会一直等 —— 这是 EBR 相比风险指针的代价，
+// 所以 EpochGuard 的作用域要尽量短：只包住"读共享指针 + 解引用"，不要包住 IO 或者等待。
+//
+// 和 ObjectPool 一样是进程级单例 + thread_local 线程记录：调用方 (无锁队列、无锁哈希表) 不需要自己传上下文。
+class EpochManager {
+public:
+  // 待回收的节点数达到这个值就尝试推进纪元
+  static constexpr size_t kCollectThreshold = 64;
+  // 每个线程最多压着多少个待回收节点 (在临界区外 Retire 时)
+  static constexpr size_t kMaxLocalPending = 16 * kCollectThreshold;
+
+  static EpochManager& Instance() {
+    static EpochManager manager;
+    return manager;
+  }
+
+  EpochManager(const EpochManager&) = delete;
+  EpochManager& operator=(const EpochManager&) = delete;
+
+  // 节点已经从共享结构上摘下 (新来的读者再也看不到它)，等所有可能还在读它的线程离场后调用 deleter
+  void Retire(void* object, void (*deleter)(void*)) {
+    ThreadRecord* record = LocalRecord();
+    // 纪元标大了只会晚释放，标小了会提前释放。屏障让调用方的摘除先于这里的读取，
+    // 读-改-写 (fetch_add 0) 总是读到最新的纪元，不会读到旧值
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = global_epoch_.fetch_add(0, std::memory_order_acq_rel);
+
+    Bag& bag = record->bags[epoch % 3];
+    if (bag.epoch != epoch) {
+      // 袋子里是 3 个 (及以上) 纪元之前的东西，早就安全了
+      FreeBag(bag);
+      bag.epoch = epoch;
+    }
+    bag.items.push_back(Retired{object, deleter});
+    pending_.fetch_add(1, std::memory_order_relaxed);
+
+    if (++record->retired_since_collect >= kCollectThreshold) {
+      record->retired_since_collect = 0;
+      TryAdvance();
+      Collect(record);
+      // 超过上界：让挡路的读者先跑完临界区
+      while (record->nesting == 0 && LocalPending(record) > kMaxLocalPending) {
+        std::this_thread::yield();
+        TryAdvance();
+        Collect(record);
+      }
+    }
+  }
+
+  template <typename T>
+  void Retire(T* object) {
+    Retire(object, [](void* p) { delete static_cast<T*>(p); });
+  }
+
+  // 尽量把能回收的都回收掉 (测试 / 关闭时用)。有读者在场时可能回收不完
+  void Flush() {
+    ThreadRecord* record = LocalRecord();
+    for (int i = 0; i < 3; ++i) {
+      TryAdvance();
+    }
+    Collect(record);
+  }
+
+  // 已经 Retire 但还没释放的节点数 (所有线程)，只用于观察 / 测试
+  size_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+  uint64_t epoch() const { return global_epoch_.load(std::memory_order_relaxed); }
+
+private:
+  friend class EpochGuard;
+
+  // 线程不在临界区
+  static constexpr uint64_t kInactive = UINT64_MAX;
+
+  struct Retired {
+    void* object;
+    void (*deleter)(void*);
+  };
+
+  struct Bag {
+    uint64_t epoch = 0;
+    std::vector<Retired> items;
+  };
+
+  // 每个线程一份，挂在全局链表上 (只增不删，线程退出后可以被新线程复用)
+  struct ThreadRecord {
+    std::atomic<uint64_t> local_epoch{kInactive};
+    std::atomic<bool> in_use{true};
+    int nesting = 0;  // EpochGuard 可以嵌套，只有最外层登记 / 注销
+    size_t retired_since_collect = 0;
+    Bag bags[3];
+    ThreadRecord* next = nullptr;
+  };
+
+  // 线程退出时把自己的记录还回去，没回收的袋子交给全局
+  struct LocalHandle {
+    ThreadRecord* record = nullptr;
+
+    ~LocalHandle() {
+      if (record != nullptr) {
+        EpochManager::Instance().ReleaseRecord(record);
+      }
+    }
+  };
+
+  EpochManager() = default;
+
+  // 单例在所有线程退出后才析构：此时没有读者，所有垃圾都可以直接释放
+  ~EpochManager() {
+    ThreadRecord* record = records_.load(std::memory_order_acquire);
+    while (record != nullptr) {
+      ThreadRecord* next = record->next;
+      for (Bag& bag : record->bags) {
+        FreeBag(bag);
+      }
+      delete record;
+      record = next;
+    }
+    for (Bag& bag : orphans_) {
+      FreeBag(bag);
+    }
+  }
+
+  ThreadRecord* LocalRecord() {
+    LocalHandle& handle = local_handle_;
+    if (handle.record == nullptr) {
+      handle.record = AcquireRecord();
+    }
+    return handle.record;
+  }
+
+  // 先找一个退出线程留下的空闲记录，没有再新建并挂到链表头 (CAS)
+  ThreadRecord* AcquireRecord() {
+    for (ThreadRecord* record = records_.load(std::memory_order_acquire); record != nullptr;
+         record = record->next) {
+      bool expected = false;
+      if (record->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return record;
+      }
+    }
+    ThreadRecord* record = new ThreadRecord();
+    record->next = records_.load(std::memory_order_relaxed);
+    while (!records_.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    return record;
+  }
+
+  void ReleaseRecord(ThreadRecord* record) {
+    {
+      std::lock_guard<std::mutex> lock(orphans_mutex_);
+      for (Bag& bag : record->bags) {
+        if (!bag.items.empty()) {
+          orphans_.push_back(std::move(bag));
+          bag = Bag();
+        }
+      }
+    }
+    record->retired_since_collect = 0;
+    record->in_use.store(false, std::memory_order_release);
+  }
+
+  // 进场：登记当前纪元。seq_cst 屏障保证登记先于之后对共享指针的读取，
+  // 推进纪元的线程要么看到我在场，要么我读到的已经是摘除之后的指针
+  void Pin(ThreadRecord* record) {
+    if (record->nesting++ == 0) {
+      record->local_epoch.store(global_epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  // 离场：release 保证临界区里的读取都发生在登记"离场"之前
+  void Unpin(ThreadRecord* record) {
+    if (--record->nesting == 0) {
+      record->local_epoch.store(kInactive, std::memory_order_release);
+    }
+  }
+
+  // 所有在场线程都已经进入当前纪元 e，才把全局纪元推进到 e + 1
+  bool TryAdvance() {
+    uint64_t epoch = global_epoch_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (ThreadRecord* record = records_.load(std::memory_order_acquire); record != nullptr;
+         record = record->next) {
+      uint64_t local = record->local_epoch.load(std::memory_order_acquire);
+      if (local != kInactive && local != epoch) {
+        return false;
+      }
+    }
+    return global_epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+  }
+
+  // 释放纪元 <= 全局纪元 - 2 的袋子：自己的 3 个，加上退出线程留下的
+  void Collect(ThreadRecord* record) {
+    uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+    for (Bag& bag : record->bags) {
+      if (bag.epoch + 2 <= epoch) {
+        FreeBag(bag);
+      }
+    }
+
+    std::vector<Bag> ready;
+    {
+      std::lock_guard<std::mutex> lock(orphans_mutex_);
+      for (size_t i = 0; i < orphans_.size();) {
+        if (orphans_[i].epoch + 2 <= epoch) {
+          ready.push_back(std::move(orphans_[i]));
+          orphans_[i] = std::move(orphans_.back());
+          orphans_.pop_back();
+        } else {
+          ++i;
+        }
+      }
+    }
+    // deleter 可能很慢 (析构大对象)，放在锁外面
+    for (Bag& bag : ready) {
+      FreeBag(bag);
+    }
+  }
+
+  static size_t LocalPending(const ThreadRecord* record) {
+    size_t count = 0;
+    for (const Bag& bag : record->bags) {
+      count += bag.items.size();
+    }
+    return count;
+  }
+
+  void FreeBag(Bag& bag) {
+    for (const Retired& item : bag.items) {
+      item.deleter(item.object);
+    }
+    pending_.fetch_sub(bag.items.size(), std::memory_order_relaxed);
+    bag.items.clear();
+  }
+
+  std::atomic<uint64_t> global_epoch_{0};
+  std::atomic<ThreadRecord*> records_{nullptr};
+  std::atomic<size_t> pending_{0};
+
+  std::mutex orphans_mutex_;
+  std::vector<Bag> orphans_;  // 已退出线程没来得及回收的袋子
+
+  static thread_local LocalHandle local_handle_;
+};
+
+// 类外定义：LocalHandle 要在 EpochManager 定义完整之后才能默认构造
+inline thread_local EpochManager::LocalHandle EpochManager::local_handle_;
+
+// 读者的 RAII 守卫：构造时进场，析构时离场。作用域内读到的节点不会被释放
+//   EpochGuard guard;
+//   Node* node = head_.load(std::memory_order_acquire);
+//   Use(node->value);  // 安全：即使 node 同时被别的线程摘下并 Retire
+class EpochGuard {
+public:
+  EpochGuard() : record_(EpochManager::Instance().LocalRecord()) { EpochManager::Instance().Pin(record_); }
+  ~EpochGuard() { EpochManager::Instance().Unpin(record_); }
+
+  EpochGuard(const EpochGuard&) = delete;
+  EpochGuard& operator=(const EpochGuard&) = delete;
+
+private:
+  EpochManager::ThreadRecord* record_;
+};
+
+#endif // Week04_Concurrency_INCLUDE_EPOCH_HPP
@@ -0,0 +1,184 @@
+#ifndef Week04_Concurrency_INCLUDE_MPMC_QUEUE_HPP
+#define Week04_Concurrency_INCLUDE_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// 有界无锁多生产者多消费者队列 (Bounded MPMC Ring, Dmitry Vyukov 的算法)
+//
+// ThreadSafeQueue 的每一次 Push / WaitAndPop 都要抢同一把 mutex：线程一多，大家都在排队等锁，
+// 甚至在锁上睡下去再被唤醒 (系统调用 + 上下文切换)。
+// 这里换成一个固定大小的环形数组，每个槽位自带一个序号 (sequence)，生产者和消费者各用一个原子下标：
+//   - 槽位 i 的序号 == pos          ：空的，轮到下标为 pos 的生产者来写
+//   - 槽位 i 的序号 == pos + 1      ：写好了，轮到下标为 pos 的消费者来读
+//   - 读完后序号设为 pos + capacity  ：空的，轮到下一圈 (pos + capacity) 的生产者
+// 生产者 CAS 抢到 enqueue_pos_ 以后，只和"同一个槽位"上的消费者打交道，不同槽位之间互不干扰。
+//
+// 两个下标各占一条 cache line (alignas(64))：生产者改 enqueue_pos_ 不会让消费者缓存里的 dequeue_pos_ 失效 (伪共享)。
+//
+// 和 ThreadSafeQueue 的区别：
+//   - 有界：满了 TryPush 返回 false，Push 会等到有空位
+//   - Push / WaitAndPop 是阻塞包装：先重试，不行再在槽位序号上 atomic::wait (futex)，不会空转烧 CPU。
+//     只有真的有人睡着 (waiters_ != 0) 才 notify：libstdc++ 对 64 位原子量的 notify 会去改一个进程级的共享计数，
+//     每次操作都 notify 的话，所有线程又都挤在同一条 cache line 上了
+//   - 容量向上取整到 2 的幂，下标取模变成按位与
+template <typename T>
+class MpmcQueue {
+public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  explicit MpmcQueue(size_t capacity = kDefaultCapacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_ = new Slot[size];
+    for (size_t i = 0; i < size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // 析构时没有并发访问：把还没被取走的元素析构掉
+  ~MpmcQueue() {
+    size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; ++pos) {
+      std::launder(reinterpret_cast<T*>(slots_[pos & mask_].storage))->~T();
+    }
+    delete[] slots_;
+  }
+
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  // 满了返回 false，不阻塞。失败时 value 原封不动
+  bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+  bool TryPush(const T& value) { return TryEmplace(value); }
+
+  // 空了返回 false，不阻塞
+  bool TryPop(T& value) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[pos & mask_];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          T* object = std::launder(reinterpret_cast<T*>(slot.storage));
+          value = std::move(*object);
+          object->~T();
+          // 槽位空出来，留给下一圈的生产者
+          slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          NotifyIfWaiting(slot);
+          return true;
+        }
+      } else if (diff < 0) {
+        // 生产者还没写到这里：队列空
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // 阻塞包装：满了就睡在"下一个要写的槽位"的序号上，消费者读走这个槽位时会叫醒
+  void Push(T value) {
+    while (!TryEmplace(std::move(value))) {
+      size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+      Slot& slot = slots_[pos & mask_];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      // 序号比 pos 小才是真的满了；比 pos 大说明 pos 已经过时，直接重试
+      if (static_cast<intptr_t>(sequence - pos) < 0) {
+        Park(slot, sequence);
+      }
+    }
+  }
+
+  // 阻塞包装：空了就睡在"下一个要读的槽位"的序号上，生产者写进这个槽位时会叫醒
+  void WaitAndPop(T& value) {
+    while (!TryPop(value)) {
+      size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+      Slot& slot = slots_[pos & mask_];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (static_cast<intptr_t>(sequence - (pos + 1)) < 0) {
+        Park(slot, sequence);
+      }
+    }
+  }
+
+  // 瞬时值：返回时可能已经变了，只用于 ThreadPool 的退出判断 / 调试
+  bool Empty() const {
+    return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos_.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Slot {
+    std::atomic<size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  // 先登记再睡：NotifyIfWaiting 看到 waiters_ 为 0 时，登记一定排在它改序号之后，
+  // 于是 wait 里重新读序号时已经变了，直接返回，不会错过唤醒
+  void Park(Slot& slot, size_t sequence) {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    slot.sequence.wait(sequence, std::memory_order_acquire);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // 改完序号后调用。fence 和 Park 里的 fence 配对 (Dekker)：要么我们看到登记，要么它看到新序号。
+  // 常见情况 (没有人睡) 只是读一下 waiters_，不写任何共享的 cache line
+  void NotifyIfWaiting(Slot& slot) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) != 0) {
+      // 不知道谁睡在这个槽位上 (生产者还是消费者)，全叫醒
+      slot.sequence.notify_all();
+    }
+  }
+
+  // 抢到槽位以后才会 move / 拷贝 value
+  template <typename U>
+  bool TryEmplace(U&& value) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[pos & mask_];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        // 槽位空着：抢这个下标。失败说明别的生产者抢先了，pos 被更新成最新值，重来
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          ::new (static_cast<void*>(slot.storage)) T(std::forward<U>(value));
+          // release：消费者看到 pos + 1 时，一定也看得到上面写进去的数据
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          NotifyIfWaiting(slot);
+          return true;
+        }
+      } else if (diff < 0) {
+        // 槽位里还是上一圈的数据：队列满了
+        return false;
+      } else {
+        // 下标已经被别的生产者用掉了，读最新的
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // 构造后只读的字段放一起，和两个频繁修改的下标隔开
+  Slot* slots_;
+  size_t mask_;
+
+  alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_{0};
+  alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_{0};
+  // 睡在某个槽位序号上的线程数。大部分时间是 0、只被读：单独一条 cache line，不被下标的修改牵连。
+  // alignas 也让整个对象的大小向上取整到 64 的倍数：waiters_ 独占最后一条 cache line
+  alignas(kCacheLineSize) std::atomic<uint32_t> waiters_{0};
+};
+
+#endif // Week04_Concurrency_INCLUDE_MPMC_QUEUE_HPP
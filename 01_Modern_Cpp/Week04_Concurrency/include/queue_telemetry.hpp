@@ -0,0 +1,107 @@
+#ifndef Week04_Concurrency_INCLUDE_QUEUE_TELEMETRY_HPP
+#define Week04_Concurrency_INCLUDE_QUEUE_TELEMETRY_HPP
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// 队列遥测：ThreadSafeQueue 的第三个模板参数
+//   - NoQueueTelemetry (默认)：所有钩子都是空的 inline 函数，元素也不带时间戳，编译出来和没有遥测的代码一模一样
+//   - QueueTelemetry：记录深度 / 高水位、每个元素在队列里待了多久 (入队时间戳 -> 出队)、锁被争抢的次数
+// 钩子都在持有队列 mutex 时调用，计数器用普通整数就够了；读取用 ThreadSafeQueue::stats() 拿一份快照
+
+// 某一时刻的快照 (拷贝出来的值，拿到以后随便读)
+struct QueueStats {
+  // latency_histogram[i]：在队列里待了 [2^(i-1), 2^i) ns 的元素个数 (i = 0 是 0ns)，最后一个桶兜底
+  static constexpr int kLatencyBuckets = 48;
+
+  size_t depth = 0;                // 拍快照时队列里的元素个数
+  size_t high_water = 0;           // 出现过的最大深度
+  uint64_t enqueued = 0;           // 累计入队
+  uint64_t dequeued = 0;           // 累计被消费者取走 (kDropOldest 挤掉的不算)
+  uint64_t lock_acquisitions = 0;  // 生产者 / 消费者加锁次数
+  uint64_t lock_contended = 0;     // 其中 try_lock 失败、不得不排队的次数
+  std::array<uint64_t, kLatencyBuckets> latency_histogram{};
+
+  // 第 q (0 ~ 1) 分位的排队时间，返回所在桶的上界 (ns)：只精确到 2 倍以内，看量级够用了
+  uint64_t LatencyPercentile(double q) const {
+    uint64_t target = static_cast<uint64_t>(q * static_cast<double>(dequeued));
+    uint64_t seen = 0;
+    for (int i = 0; i < kLatencyBuckets; ++i) {
+      seen += latency_histogram[i];
+      if (seen > target) {
+        return uint64_t{1} << i;
+      }
+    }
+    return uint64_t{1} << (kLatencyBuckets - 1);
+  }
+
+  double ContentionRate() const {
+    return lock_acquisitions == 0 ? 0.0 : static_cast<double>(lock_contended) / lock_acquisitions;
+  }
+};
+
+struct NoQueueTelemetry {
+  static constexpr bool kEnabled = false;
+
+  struct Stamp {};
+  static Stamp Now() { return {}; }
+
+  void OnLock(bool /*contended*/) {}
+  void OnEnqueue(size_t /*depth*/) {}
+  void OnDequeue(Stamp /*enqueued*/, Stamp /*now*/) {}
+};
+
+class QueueTelemetry {
+public:
+  static constexpr bool kEnabled = true;
+
+  using Stamp = std::chrono::steady_clock::time_point;
+  static Stamp Now() { return std::chrono::steady_clock::now(); }
+
+  void OnLock(bool contended) {
+    ++stats_.lock_acquisitions;
+    if (contended) {
+      ++stats_.lock_contended;
+    }
+  }
+
+  void OnEnqueue(size_t depth) {
+    ++stats_.enqueued;
+    if (depth > stats_.high_water) {
+      stats_.high_water = depth;
+    }
+  }
+
+  void OnDequeue(Stamp enqueued, Stamp now) {
+    ++stats_.dequeued;
+    auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(now - enqueued).count();
+    // bit_width(ns)：0 -> 0, 1 -> 1, [2, 4) -> 2, [4, 8) -> 3 ... 一条指令算出对数桶
+    int bucket = static_cast<int>(std::bit_width(static_cast<uint64_t>(waited > 0 ? waited : 0)));
+    if (bucket >= QueueStats::kLatencyBuckets) {
+      bucket = QueueStats::kLatencyBuckets - 1;
+    }
+    ++stats_.latency_histogram[bucket];
+  }
+
+  // 把另一份 (比如 DrainAll 在锁外记的) 出队统计加进来
+  void MergeDequeues(const QueueTelemetry& other) {
+    stats_.dequeued += other.stats_.dequeued;
+    for (int i = 0; i < QueueStats::kLatencyBuckets; ++i) {
+      stats_.latency_histogram[i] += other.stats_.latency_histogram[i];
+    }
+  }
+
+  QueueStats Snapshot(size_t depth) const {
+    QueueStats stats = stats_;
+    stats.depth = depth;
+    return stats;
+  }
+
+private:
+  QueueStats stats_;
+};
+
+#endif // Week04_Concurrency_INCLUDE_QUEUE_TELEMETRY_HPP
@@ -0,0 +1,218 @@
+#ifndef Week04_Concurrency_INCLUDE_SPSC_QUEUE_HPP
+#define Week04_Concurrency_INCLUDE_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <utility>
+
+// 单生产者单消费者环形队列 (SPSC Ring)
+//
+// 流水线里很多交接点只有一个生产者、一个消费者 (比如 queue_test.cpp 里的 Producer / Consumer)。
+// 这种情况下 ThreadSafeQueue 的 mutex + 条件变量完全是浪费，MpmcQueue 的 CAS 也用不着：
+//   - tail_ 只有生产者写，head_ 只有消费者写，各自一条 cache line
+//   - 写自己的下标用 release store，读对方的下标用 acquire load，没有任何 CAS / lock 前缀 (wait-free)
+//   - 缓存对方的下标：生产者记着上次看到的 head (cached_head_)，只有按缓存算"满了"才重新读一次 head_；
+//     消费者同理缓存 tail。大部分操作根本不碰对方的 cache line
+//   - 批量读写 (TryPushBulk / TryPopBulk)：一批只发布一次下标，对方只被打扰一次
+//
+// 阻塞模式 (kBlocking = true)：Push / WaitAndPop 只在真的满 / 空时先让出几次 CPU，还不行再在对方的下标上
+// atomic::wait (futex) 睡下去。睡之前先举个牌子 (consumer_waiting_ / producer_waiting_)，发布下标的一方
+// 只有看到牌子才 notify_one：libstdc++ 对 64 位原子量的 notify 不管有没有人在等，都要对进程级的等待者表做一次
+// seq_cst 的原子加，每个元素都来一次就把无锁的好处吃掉了。常见情况下只多一个 fence 和一次读。
+// 非阻塞模式 (默认) 的 Push / WaitAndPop 自旋 + yield，适合两个线程各自独占一个核的场景。
+//
+// 容量向上取整到 2 的幂。下标只增不减，用 (tail - head) 算元素个数，取模用按位与。
+template <typename T, bool kBlocking = false>
+class SpscQueue {
+public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  explicit SpscQueue(size_t capacity = kDefaultCapacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_ = new Slot[size];
+  }
+
+  // 析构时没有并发访问：把还没被取走的元素析构掉
+  ~SpscQueue() {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    for (size_t pos = head_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+      Object(pos)->~T();
+    }
+    delete[] slots_;
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // ---------------- 生产者线程 ----------------
+
+  // 满了返回 false，value 原封不动
+  bool TryPush(T&& value) { return TryEmplace(std::move(value)); }
+  bool TryPush(const T& value) { return TryEmplace(value); }
+
+  // 把 items[0, count) 尽量多地 move 进队列，只发布一次 tail_。返回实际放进去的个数
+  size_t TryPushBulk(T* items, size_t count) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t free_slots = capacity() - (tail - cached_head_);
+    if (free_slots < count) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      free_slots = capacity() - (tail - cached_head_);
+    }
+    size_t n = count < free_slots ? count : free_slots;
+    for (size_t i = 0; i < n; ++i) {
+      ::new (static_cast<void*>(slots_[(tail + i) & mask_].storage)) T(std::move(items[i]));
+    }
+    if (n > 0) {
+      Publish(tail_, tail + n, consumer_waiting_);
+    }
+    return n;
+  }
+
+  // 满了就等
+  void Push(T value) {
+    while (!TryEmplace(std::move(value))) {
+      // 满：head_ 停在 tail - capacity，等消费者把它往前推
+      Wait(head_, tail_.load(std::memory_order_relaxed) - capacity(), producer_waiting_);
+    }
+  }
+
+  // ---------------- 消费者线程 ----------------
+
+  // 空了返回 false
+  bool TryPop(T& value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    T* object = Object(head);
+    value = std::move(*object);
+    object->~T();
+    Publish(head_, head + 1, producer_waiting_);
+    return true;
+  }
+
+  // 一次最多取 max_count 个 move 到 out[]，只发布一次 head_。返回实际取到的个数
+  size_t TryPopBulk(T* out, size_t max_count) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t available = cached_tail_ - head;
+    if (available < max_count) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      available = cached_tail_ - head;
+    }
+    size_t n = max_count < available ? max_count : available;
+    for (size_t i = 0; i < n; ++i) {
+      T* object = Object(head + i);
+      out[i] = std::move(*object);
+      object->~T();
+    }
+    if (n > 0) {
+      Publish(head_, head + n, producer_waiting_);
+    }
+    return n;
+  }
+
+  // 空了就等
+  void WaitAndPop(T& value) {
+    while (!TryPop(value)) {
+      // 空：tail_ 停在 head，等生产者把它往前推
+      Wait(tail_, head_.load(std::memory_order_relaxed), consumer_waiting_);
+    }
+  }
+
+  // ---------------- 任意线程 (瞬时值) ----------------
+
+  // 先读 head_ 再读 tail_：head_ 永远不会超过 tail_，而 tail_ 只增不减，后读到的 tail 一定 >= 先读到的 head。
+  // 反过来读的话，两次读之间消费者可能把 head_ 推过旧的 tail，相减回绕成接近 SIZE_MAX，Empty() 就错了
+  size_t size() const {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  bool Empty() const { return size() == 0; }
+
+  size_t capacity() const { return mask_ + 1; }
+
+private:
+  static constexpr size_t kCacheLineSize = 64;
+  static constexpr int kYieldsBeforePark = 16;
+
+  struct Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  T* Object(size_t pos) { return std::launder(reinterpret_cast<T*>(slots_[pos & mask_].storage)); }
+
+  template <typename U>
+  bool TryEmplace(U&& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == capacity()) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == capacity()) {
+        return false;
+      }
+    }
+    ::new (static_cast<void*>(slots_[tail & mask_].storage)) T(std::forward<U>(value));
+    Publish(tail_, tail + 1, consumer_waiting_);
+    return true;
+  }
+
+  // release：对方读到新下标时，一定也看得到下标之前写进去 / 读出来的数据。
+  // waiting 是对方睡在 index 上时举的牌子：fence 和 Wait 里的 fence 配对 (Dekker)，
+  // 要么我们看到牌子去叫醒，要么对方在 wait 里重新读下标时已经看到了新值，不会睡过去
+  static void Publish(std::atomic<size_t>& index, size_t value, const std::atomic<bool>& waiting) {
+    index.store(value, std::memory_order_release);
+    if constexpr (kBlocking) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (waiting.load(std::memory_order_relaxed)) {
+        index.notify_one();
+      }
+    }
+  }
+
+  // 等对方的下标离开 stuck 这个值。阻塞模式下先让出几次 CPU 再睡：
+  // 对方往往马上就会推进下标，直接睡下去每个元素都要一次 futex 唤醒
+  static void Wait(const std::atomic<size_t>& index, size_t stuck, std::atomic<bool>& waiting) {
+    if constexpr (kBlocking) {
+      for (int i = 0; i < kYieldsBeforePark; ++i) {
+        if (index.load(std::memory_order_acquire) != stuck) {
+          return;
+        }
+        std::this_thread::yield();
+      }
+      waiting.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      index.wait(stuck, std::memory_order_acquire);
+      waiting.store(false, std::memory_order_relaxed);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  // 构造后只读
+  Slot* slots_;
+  size_t mask_;
+
+  // 消费者独占：head_ 和它缓存的 tail
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+  size_t cached_tail_ = 0;
+
+  // 生产者独占：tail_ 和它缓存的 head
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  size_t cached_head_ = 0;
+
+  // 阻塞模式下"我睡在对方的下标上了"的牌子：只在真的要睡时才写，平时两边都只读，单独一条 cache line
+  alignas(kCacheLineSize) std::atomic<bool> consumer_waiting_{false};  // 消费者睡在 tail_ 上
+  std::atomic<bool> producer_waiting_{false};                          // 生产者睡在 head_ 上
+};
+
+#endif // Week04_Concurrency_INCLUDE_SPSC_QUEUE_HPP
@@ -3,26 +3,127 @@
 
 #include <vector>
 #include <thread>
-#include <functional> 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 #include "thread_safe_queue.hpp" // 复用我们刚才写的队列
+#include "unique_function.hpp"
 
-class ThreadPool {
+// 任务队列的类型是模板参数：
+//   - 默认 ThreadSafeQueue：mutex + 条件变量，无界
+//   - MpmcQueue (mpmc_queue.hpp)：无锁有界环形队列，线程多、任务小的时候不会都堵在一把锁上
+//     BasicThreadPool<MpmcQueue> pool(8);
+//   - InstrumentedQueue：ThreadSafeQueue + 遥测，queue_stats() 能看到任务排队情况
+// 队列需要提供 Push / WaitAndPop；用到 TrySubmit 时还要有 TryPush，用到 RunPendingTask 时还要有 TryPop，
+// 用到有界构造函数时要能用容量构造，用到 queue_stats() 时要有 stats()。
+// 有 ForcePush (不受容量限制的放入) 的队列，析构时的毒药丸走它：有界队列满了也不会被拒、被挤掉或者卡住
+//
+// 析构：先停止接收新任务，再给每个 worker 发一颗毒药丸 (空任务)。药丸排在已提交的任务后面，
+// worker 只在吃到药丸时下班，所以已经进了队列的任务都会跑完。
+template <template <typename> class Queue = ThreadSafeQueue>
+class BasicThreadPool {
 public:
   // 它可以装入任何不接受参数且没有返回值（void()）的函数、Lambda 表达式或者仿函数。
   // void() 并不是指函数名，而是指函数签名
-  using Task = std::function<void()>;
+  // 用 UniqueFunction 而不是 std::function：Lambda 可以直接捕获 Socket 这种只能移动的对象，
+  // 捕获的东西在 48 字节以内时提交任务不分配内存
+  using Task = UniqueFunction<void()>;
 
-  // 构造函数：启动固定数量的线程
-  explicit ThreadPool(int num_threads) : stop_(false) {
+  // 构造函数：启动固定数量的线程 (任务队列无界)
+  explicit BasicThreadPool(int num_threads) : stop_(false) {
+    StartWorkers(num_threads);
+  }
+
+  // 任务队列有上限：最多积压 queue_capacity 个任务。
+  // 队列满了 Submit 会等 (反压给提交方)，TrySubmit 立刻返回 false (让提交方自己降级，比如拒绝新连接)
+  BasicThreadPool(int num_threads, size_t queue_capacity) : queue_(queue_capacity), stop_(false) {
+    StartWorkers(num_threads);
+  }
+
+  // 析构函数
+  ~BasicThreadPool() {
+    // 1. 告诉大家准备下班
+    stop_ = true;
+
+    // 2. 发送“空任务”作为信号 
+    // 为什么要发空任务？因为如果线程都在 WaitAndPop 睡觉，需要 push 东西进去把它们唤醒。
+    size_t total = workers_.size();
+    for (size_t i = 0; i < total; ++i) {
+      PushPill();
+    }
+
+    // 药丸可能被 RunPendingTask 截走 (它不放回去，见那里的注释)：记在 stray_pills_ 上，由这里补发，
+    // 直到每个 worker 都吃到了自己的那颗
+    while (exited_.load() < total) {
+      uint32_t seen = shutdown_events_.load();
+      int owed = stray_pills_.exchange(0);
+      for (; owed > 0; --owed) {
+        PushPill();
+      }
+      if (exited_.load() < total && stray_pills_.load() == 0) {
+        shutdown_events_.wait(seen);
+      }
+    }
+
+    // 3. 等待所有线程真正结束 (Join)
+    for (auto& worker : workers_) {
+      if (worker.joinable()) { // joinable() 返回 true 表示这个线程还在活跃（或者已经跑完但还没汇报）
+        worker.join(); // join() 的作用：主线程阻塞等待子线程结束。
+      }
+    }
+  }
+
+  // 提交任务的接口
+  void Submit(Task task) {
+    // 只要没喊停，就往队列里塞任务
+    if (!stop_) {
+        queue_.Push(std::move(task));
+    }
+  }
+
+  // 不等待的提交：队列满了 (或者已经在析构) 返回 false，任务没有被接收，task 原封不动
+  // (调用方还能处理它捕获的东西，比如给被拒绝的连接回一句 Busy)
+  bool TrySubmit(Task&& task) {
+    if (stop_) {
+      return false;
+    }
+    return queue_.TryPush(std::move(task));
+  }
+
+  // 在当前线程 (可以是 worker，也可以是外面的线程) 取一个排队的任务来跑。队列空了返回 false。
+  // 任务里要等它提交的子任务时 (fork-join)，不能干等：所有 worker 都在等的话，子任务永远没人跑 (死锁)。
+  // 边等边帮忙：while (!done) { if (!pool.RunPendingTask()) std::this_thread::yield(); }
+  // 需要队列有 TryPop
+  bool RunPendingTask() {
+    Task task;
+    if (!queue_.TryPop(task)) {
+      return false;
+    }
+    if (task == nullptr) {
+      // 析构时发给 worker 的"毒药丸"，不是我们的。不能在这里放回去：有界队列满了会卡住 (生产者还在往里填)，
+      // 调用方又可能是一个 worker。交给析构函数补发
+      stray_pills_.fetch_add(1);
+      SignalShutdownEvent();
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  // 任务队列的遥测快照：积压深度 / 高水位、任务排队多久才被 worker 拿走、锁争抢率。
+  // 只有队列开了遥测才能调用：BasicThreadPool<InstrumentedQueue> pool(4);
+  QueueStats queue_stats() const { return queue_.stats(); }
+
+private:
+  void StartWorkers(int num_threads) {
     for (int i = 0; i < num_threads; ++i) {
       // emplace_back 直接在 vector 尾部构造 std::thread 对象
       // 每个线程都在跑下面这个 lambda 表达式
       workers_.emplace_back([this] {
         // while(true) 是写在一个 Lambda 表达式里的，而这个 Lambda 被交给了 std::thread 去在一个“平行时空”里运行。
         while (true) {
-          // task 是一个 std::function<void()> 类型的对象。
+          // task 是一个 Task (UniqueFunction<void()>) 类型的对象。
           //   它的状态：空的 (Empty)。它里面没有代码，什么都干不了。
           //   它的身份：它只是一个容器，准备用来装东西。
           //   它代表什么函数：此时此刻，它不代表任何函数。
@@ -34,52 +135,47 @@ public:
           // 函数内是将我们需要的给到 value
           queue_.WaitAndPop(task);
 
-          // 2. 检查是不是“毒药丸”或者停止信号
-          // 如果在 WaitAndPop 中没有取到数据，task就是 nullptr
-          // 如果任务是空的 (nullptr) 或者 收到停止信号且队列空了
-          if (task == nullptr || (stop_ && queue_.Empty())) {
+          // 2. 检查是不是“毒药丸”
+          // 只认药丸，不看 stop_：已经取出来的真任务 (比如 Week05 里接受的 Socket) 必须跑，不能丢；
+          // 每个 worker 恰好吃掉一颗，也不会有药丸剩在队列里
+          if (task == nullptr) {
+             exited_.fetch_add(1);
+             SignalShutdownEvent();
              return; // 线程函数返回，意味着线程结束（下班）
           }
 
           // 3. 执行任务
-          // 这就是 std::function 的魔力，像调用普通函数一样调用它
+          // 这就是类型擦除的魔力 (和 std::function 一样)，像调用普通函数一样调用它
           task();
         }
       });
     }
   }
 
-  // 析构函数
-  ~ThreadPool() {
-    // 1. 告诉大家准备下班
-    stop_ = true;
-
-    // 2. 发送“空任务”作为信号 
-    // 为什么要发空任务？因为如果线程都在 WaitAndPop 睡觉，需要 push 东西进去把它们唤醒。
-    for (int i = 0; i < workers_.size(); ++i) {
+  // 有 ForcePush 就绕过容量限制；没有的 (MpmcQueue) 只能 Push：满了会等，但 worker 一直在取，总能放进去
+  void PushPill() {
+    if constexpr (requires { queue_.ForcePush(Task{}); }) {
+      queue_.ForcePush(nullptr);
+    } else {
       queue_.Push(nullptr);
     }
-
-    // 3. 等待所有线程真正结束 (Join)
-    for (auto& worker : workers_) {
-      if (worker.joinable()) { // joinable() 返回 true 表示这个线程还在活跃（或者已经跑完但还没汇报）
-        worker.join(); // join() 的作用：主线程阻塞等待子线程结束。
-      }
-    }
   }
 
-  // 提交任务的接口
-  void Submit(Task task) {
-    // 只要没喊停，就往队列里塞任务
-    if (!stop_) {
-        queue_.Push(task);
-    }
+  // 析构函数在 shutdown_events_ 上等：worker 下班、药丸被截走，都换一个值再叫醒它
+  void SignalShutdownEvent() {
+    shutdown_events_.fetch_add(1);
+    shutdown_events_.notify_all();
   }
 
-private:
   std::vector<std::thread> workers_;    // 工作线程组
-  ThreadSafeQueue<Task> queue_;         // 任务队列（复用之前的代码）
+  Queue<Task> queue_;                   // 任务队列（复用之前的代码）
   std::atomic<bool> stop_;              // 停止标志
+  std::atomic<size_t> exited_{0};       // 已经吃到药丸下班的 worker 数
+  std::atomic<int> stray_pills_{0};     // 被 RunPendingTask 截走、还没补发的药丸
+  std::atomic<uint32_t> shutdown_events_{0};
 };
 
+// 原来的 ThreadPool 就是用 ThreadSafeQueue 的版本
+using ThreadPool = BasicThreadPool<>;
+
 #endif // THREAD_POOL_HPP
\ No newline at end of file
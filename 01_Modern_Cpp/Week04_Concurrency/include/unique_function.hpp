@@ -0,0 +1,142 @@
+#ifndef Week04_Concurrency_INCLUDE_UNIQUE_FUNCTION_HPP
+#define Week04_Concurrency_INCLUDE_UNIQUE_FUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 只能移动的函数包装 (Move-Only Function，类似 C++23 的 std::move_only_function)
+//
+// std::function 有两个问题：
+//   1. 要求可调用对象"可拷贝"：Lambda 捕获了 Socket / unique_ptr 这种只能移动的东西就放不进去，
+//      只好先包一层 shared_ptr (一次堆分配 + 原子引用计数)
+//   2. 内联缓冲很小 (libstdc++ 是 16 字节，而且只放可平凡拷贝的对象)：捕获稍微多一点就要 new 一块
+// UniqueFunction 不支持拷贝，换来：
+//   - 只要求可调用对象能移动
+//   - kInlineSize (48) 字节以内、移动构造不抛异常的可调用对象直接放在对象内部，不分配内存；
+//     放不下的才 new 到堆上 (此时移动 UniqueFunction 只是搬一个指针)
+//   - sizeof(UniqueFunction) == 64：一条 cache line
+//
+// 类型擦除的方式：每种可调用对象类型对应一张静态的函数表 (Ops)，对象里只存一个指向它的指针。
+template <typename Signature>
+class UniqueFunction;
+
+template <typename R, typename... Args>
+class UniqueFunction<R(Args...)> {
+public:
+  static constexpr size_t kInlineSize = 48;
+  static constexpr size_t kInlineAlign = alignof(std::max_align_t);
+
+  UniqueFunction() noexcept = default;
+  UniqueFunction(std::nullptr_t) noexcept {}  // 允许 queue.Push(nullptr) 这种写法 (线程池的"毒药丸")
+
+  template <typename F, typename Functor = std::decay_t<F>,
+            typename = std::enable_if_t<!std::is_same_v<Functor, UniqueFunction> &&
+                                        std::is_invocable_r_v<R, Functor&, Args...>>>
+  UniqueFunction(F&& f) {
+    if constexpr (kStoredInline<Functor>) {
+      ::new (static_cast<void*>(storage_)) Functor(std::forward<F>(f));
+    } else {
+      ::new (static_cast<void*>(storage_)) Functor*(new Functor(std::forward<F>(f)));
+    }
+    ops_ = &kOps<Functor>;
+  }
+
+  UniqueFunction(UniqueFunction&& other) noexcept { MoveFrom(other); }
+
+  UniqueFunction& operator=(UniqueFunction&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  UniqueFunction& operator=(std::nullptr_t) noexcept {
+    Reset();
+    return *this;
+  }
+
+  UniqueFunction(const UniqueFunction&) = delete;
+  UniqueFunction& operator=(const UniqueFunction&) = delete;
+
+  ~UniqueFunction() { Reset(); }
+
+  // 非 const：允许 mutable Lambda 修改自己捕获的东西 (比如把捕获的 Socket move 出去)
+  R operator()(Args... args) { return ops_->invoke(storage_, std::forward<Args>(args)...); }
+
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+  friend bool operator==(const UniqueFunction& f, std::nullptr_t) noexcept { return f.ops_ == nullptr; }
+
+private:
+  struct Ops {
+    R (*invoke)(void* storage, Args&&... args);
+    void (*move)(void* dst, void* src) noexcept;  // 把 src 里的对象搬到 dst，并销毁 src 里的
+    void (*destroy)(void* storage) noexcept;
+  };
+
+  // 放得下、对齐够、移动不抛异常 (UniqueFunction 的移动是 noexcept 的) 才放在对象内部
+  template <typename Functor>
+  static constexpr bool kStoredInline = sizeof(Functor) <= kInlineSize && alignof(Functor) <= kInlineAlign &&
+                                        std::is_nothrow_move_constructible_v<Functor>;
+
+  template <typename Functor>
+  static Functor* Get(void* storage) {
+    if constexpr (kStoredInline<Functor>) {
+      return std::launder(reinterpret_cast<Functor*>(storage));
+    } else {
+      return *std::launder(reinterpret_cast<Functor**>(storage));
+    }
+  }
+
+  template <typename Functor>
+  static R Invoke(void* storage, Args&&... args) {
+    return (*Get<Functor>(storage))(std::forward<Args>(args)...);
+  }
+
+  template <typename Functor>
+  static void Move(void* dst, void* src) noexcept {
+    if constexpr (kStoredInline<Functor>) {
+      Functor* from = Get<Functor>(src);
+      ::new (dst) Functor(std::move(*from));
+      from->~Functor();
+    } else {
+      // 堆上的对象不动，只搬指针
+      ::new (dst) Functor*(Get<Functor>(src));
+    }
+  }
+
+  template <typename Functor>
+  static void Destroy(void* storage) noexcept {
+    if constexpr (kStoredInline<Functor>) {
+      Get<Functor>(storage)->~Functor();
+    } else {
+      delete Get<Functor>(storage);
+    }
+  }
+
+  template <typename Functor>
+  static constexpr Ops kOps = {&Invoke<Functor>, &Move<Functor>, &Destroy<Functor>};
+
+  void MoveFrom(UniqueFunction& other) noexcept {
+    if (other.ops_ != nullptr) {
+      other.ops_->move(storage_, other.storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() noexcept {
+    if (ops_ != nullptr) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  alignas(kInlineAlign) unsigned char storage_[kInlineSize];
+  const Ops* ops_ = nullptr;
+};
+
+#endif // Week04_Concurrency_INCLUDE_UNIQUE_FUNCTION_HPP
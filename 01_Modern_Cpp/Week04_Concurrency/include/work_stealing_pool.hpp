@@ -0,0 +1,212 @@
+#ifndef Week04_Concurrency_INCLUDE_WORK_STEALING_POOL_HPP
+#define Week04_Concurrency_INCLUDE_WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "chase_lev_deque.hpp"
+#include "thread_safe_queue.hpp"
+#include "unique_function.hpp"
+
+// 工作窃取线程池 (Work-Stealing Thread Pool)
+//
+// ThreadPool 的所有 worker 都从同一个 ThreadSafeQueue 取任务：任务一小、worker 一多，大家都堵在那一把锁上。
+// 分治 (fork-join) 类的任务更糟：每拆一次子任务都要过一次全局锁。这里换成：
+//   - 每个 worker 一个自己的 ChaseLevDeque。worker 里面 Submit 的任务 (子任务) 推进自己的 deque，
+//     自己从底部后进先出地取，不和任何人争 (没有锁，没有 CAS)
+//   - 外面的线程 Submit 的任务进全局的注入队列 (injection_)，worker 一次搬一小批到自己的 deque 里，
+//     这样别的 worker 也能从它那里偷
+//   - 自己没活干了，从一个随机的 worker 开始挨个偷 (从顶部偷最老、通常也是最大的那块)
+//   - 哪里都找不到活就睡在 signal_ 上 (atomic::wait)；有新任务并且确实有人在睡时才去叫醒
+//
+// 接口和 ThreadPool 一样 (Submit / RunPendingTask)，析构时会把已经提交的任务跑完再退出。
+// 和 ThreadPool 一样：外部线程的 Submit 不能和析构同时进行 (调用方保证析构前所有外部提交都已返回)。
+class WorkStealingThreadPool {
+public:
+  using Task = UniqueFunction<void()>;
+
+  explicit WorkStealingThreadPool(int num_threads) {
+    for (int i = 0; i < num_threads; ++i) {
+      workers_.push_back(std::make_unique<Worker>(this, i));
+    }
+    // 所有 Worker 都建好了再启动线程：线程一起来就可能去偷别人的 deque
+    for (auto& worker : workers_) {
+      Worker* self = worker.get();
+      threads_.emplace_back([this, self] { WorkerLoop(self); });
+    }
+  }
+
+  ~WorkStealingThreadPool() {
+    stop_.store(true, std::memory_order_seq_cst);
+    signal_.fetch_add(1, std::memory_order_seq_cst);
+    signal_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+    // 防漏：join 返回之前进了队列、却没人来得及跑的任务 (正常用法下这里是空的) 不执行，只释放。
+    // 这不能让"和析构同时进行的 Submit"变安全：Push 可能落在这段循环之后，甚至 injection_ 已经析构之后
+    Task* task = nullptr;
+    while (injection_.TryPop(task)) {
+      delete task;
+    }
+    for (auto& worker : workers_) {
+      while (worker->deque.Pop(task)) {
+        delete task;
+      }
+    }
+  }
+
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  // 在本池的 worker 里调用：进自己的 deque (只有自己在用的那一头，不加锁)；在别的线程调用：进注入队列
+  // 外部线程的 Submit 必须在析构开始之前返回 (和 ThreadPool 一样，不能和析构重叠)；
+  // 析构过程中 worker 里提交的子任务照收，保证已经在跑的任务能跑完
+  void Submit(Task task) {
+    Worker* self = current_worker_;
+    if (self != nullptr && self->pool == this) {
+      self->deque.Push(new Task(std::move(task)));
+      // 自己醒着，任务不会丢：只是看看有没有闲着睡觉的，有就叫一个起来偷
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (sleepers_.load(std::memory_order_relaxed) > 0) {
+        WakeOne();
+      }
+    } else if (!stop_.load(std::memory_order_relaxed)) {
+      injection_.Push(new Task(std::move(task)));
+      WakeOne();
+    }
+  }
+
+  // 在当前线程找一个任务来跑 (本地 deque -> 注入队列 -> 偷)，找不到返回 false。
+  // fork-join 等子任务时用它边等边帮忙：while (!done) { if (!pool.RunPendingTask()) std::this_thread::yield(); }
+  bool RunPendingTask() {
+    Worker* self = current_worker_;
+    if (self != nullptr && self->pool != this) {
+      self = nullptr;
+    }
+    Task* task = FindTask(self);
+    if (task == nullptr) {
+      return false;
+    }
+    Run(task);
+    return true;
+  }
+
+  int size() const { return static_cast<int>(workers_.size()); }
+
+private:
+  // 注入队列里一次最多搬多少个到自己的 deque：搬一批过来，别的 worker 才有得偷
+  static constexpr size_t kInjectionBatch = 32;
+
+  struct Worker {
+    Worker(WorkStealingThreadPool* owner, int worker_index)
+        : pool(owner), rng(0x9E3779B97F4A7C15ULL * (worker_index + 1)) {}
+
+    WorkStealingThreadPool* pool;
+    uint64_t rng;  // 选偷窃目标用的 xorshift 状态，只有自己用
+    ChaseLevDeque<Task*> deque;
+    std::vector<Task*> batch;  // 从注入队列搬任务的临时缓冲
+  };
+
+  static void Run(Task* task) {
+    std::unique_ptr<Task> owned(task);
+    (*owned)();
+  }
+
+  void WorkerLoop(Worker* self) {
+    current_worker_ = self;
+    while (true) {
+      // 睡之前记下 signal_：找完一圈没找到、准备睡的这段时间里要是有人提交了任务，signal_ 就变了，不会睡过头
+      uint32_t seen = signal_.load(std::memory_order_seq_cst);
+      Task* task = FindTask(self);
+      if (task != nullptr) {
+        Run(task);
+        continue;
+      }
+      if (stop_.load(std::memory_order_seq_cst)) {
+        // 析构：到处都没有活了才下班 (别的 worker 还在跑的任务再拆出来的子任务，它自己会跑完)
+        break;
+      }
+      sleepers_.fetch_add(1, std::memory_order_seq_cst);
+      // 登记完再找一次：Submit 在登记之前看 sleepers_ 的话可能以为没人在睡、不叫醒
+      task = FindTask(self);
+      if (task == nullptr && !stop_.load(std::memory_order_seq_cst)) {
+        signal_.wait(seen, std::memory_order_seq_cst);
+      }
+      sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+      if (task != nullptr) {
+        Run(task);
+      }
+    }
+    current_worker_ = nullptr;
+  }
+
+  // self 为空表示调用方不是本池的 worker：没有自己的 deque，只能从注入队列拿或者去偷
+  Task* FindTask(Worker* self) {
+    Task* task = nullptr;
+    if (self != nullptr && self->deque.Pop(task)) {
+      return task;
+    }
+    if (self != nullptr) {
+      self->batch.clear();
+      if (injection_.PopUpTo(kInjectionBatch, self->batch) > 0) {
+        // 第一个自己跑，剩下的放进自己的 deque 给别人偷
+        for (size_t i = 1; i < self->batch.size(); ++i) {
+          self->deque.Push(self->batch[i]);
+        }
+        if (self->batch.size() > 1 && sleepers_.load(std::memory_order_seq_cst) > 0) {
+          WakeOne();
+        }
+        return self->batch[0];
+      }
+    } else if (injection_.TryPop(task)) {
+      return task;
+    }
+    return Steal(self);
+  }
+
+  // 从一个随机的 worker 开始挨个偷一圈。随机起点：小偷们不会都扑向同一个受害者
+  Task* Steal(Worker* self) {
+    size_t count = workers_.size();
+    size_t start = 0;
+    if (self != nullptr) {
+      self->rng ^= self->rng << 13;
+      self->rng ^= self->rng >> 7;
+      self->rng ^= self->rng << 17;
+      start = static_cast<size_t>(self->rng % count);
+    }
+    Task* task = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+      Worker* victim = workers_[(start + i) % count].get();
+      if (victim != self && victim->deque.Steal(task)) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  // 有任务可偷了：signal_ 换一个值 (睡着的人等的是旧值)，确实有人在睡才进内核
+  void WakeOne() {
+    signal_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+      signal_.notify_one();
+    }
+  }
+
+  // 当前线程是哪个池的哪个 worker (不是 worker 的线程为空)
+  static thread_local Worker* current_worker_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;  // 构造完就不再变：小偷可以不加锁地遍历
+  std::vector<std::thread> threads_;
+  ThreadSafeQueue<Task*> injection_;              // 外部线程提交的任务
+  std::atomic<uint32_t> signal_{0};
+  std::atomic<int> sleepers_{0};
+  std::atomic<bool> stop_{false};
+};
+
+inline thread_local WorkStealingThreadPool::Worker* WorkStealingThreadPool::current_worker_ = nullptr;
+
+#endif // Week04_Concurrency_INCLUDE_WORK_STEALING_POOL_HPP
@@ -0,0 +1,62 @@
+// ThreadSafeQueue 批量操作的吞吐量：一个生产者、一个消费者，每批 N 个
+//   - N = 1：Push / WaitAndPop，每个元素一次加锁 + 一次 notify
+//   - N > 1：PushBulk / WaitAndPopUpTo，每批一次加锁 + 一次 notify
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "thread_safe_queue.hpp"
+
+const int kItems = 4000000;
+
+void Run(int batch_size) {
+  ThreadSafeQueue<int> queue;
+  long long sink = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  std::thread consumer([&] {
+    long long sum = 0;
+    std::vector<int> batch;
+    for (int received = 0; received < kItems;) {
+      if (batch_size == 1) {
+        int value = 0;
+        queue.WaitAndPop(value);
+        sum += value;
+        ++received;
+      } else {
+        batch.clear();
+        received += static_cast<int>(queue.WaitAndPopUpTo(batch_size, batch));
+        for (int value : batch) sum += value;
+      }
+    }
+    sink = sum;
+  });
+
+  std::vector<int> batch;
+  for (int next = 0; next < kItems;) {
+    if (batch_size == 1) {
+      queue.Push(next++);
+    } else {
+      batch.clear();
+      for (int i = 0; i < batch_size && next < kItems; ++i) batch.push_back(next++);
+      queue.PushBulk(batch);
+    }
+  }
+  consumer.join();
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "  batch=" << batch_size << ": " << kItems / seconds / 1e6 << " M items/sec  (sink=" << sink << ")"
+            << std::endl;
+}
+
+int main() {
+  std::cout << "=== ThreadSafeQueue Batch Benchmark ===" << std::endl;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+  for (int batch_size : {1, 4, 16, 64, 256, 1024}) {
+    Run(batch_size);
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+// fork-join 负载：ThreadPool (所有 worker 共用一个加锁的队列) vs WorkStealingThreadPool (每个 worker 一个 Chase-Lev deque)
+//   - fib(n)：递归拆成两半，小于 cutoff 才串行算。任务又小又多，每次拆分都要提交一次 -> 主要在量调度开销
+//   - 并行求和：把数组二分到 kSumGrain 个元素一块，叶子任务干的活多一些
+// 等子任务时不能干等 (worker 全在等就死锁了)，两种池都用 RunPendingTask 边等边帮忙。
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.hpp"
+#include "work_stealing_pool.hpp"
+
+const int kFibN = 30;
+const int kFibCutoff = 12;
+const size_t kSumSize = size_t{1} << 24;
+const size_t kSumGrain = size_t{1} << 13;
+
+long long SerialFib(int n) { return n < 2 ? n : SerialFib(n - 1) + SerialFib(n - 2); }
+
+template <typename Pool>
+void HelpUntil(Pool& pool, const std::atomic<bool>& done) {
+  while (!done.load(std::memory_order_acquire)) {
+    if (!pool.RunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename Pool>
+long long Fib(Pool& pool, int n) {
+  if (n < kFibCutoff) {
+    return SerialFib(n);
+  }
+  long long left = 0;
+  std::atomic<bool> done{false};
+  pool.Submit([&] {
+    left = Fib(pool, n - 1);
+    done.store(true, std::memory_order_release);
+  });
+  long long right = Fib(pool, n - 2);
+  HelpUntil(pool, done);
+  return left + right;
+}
+
+template <typename Pool>
+int64_t Sum(Pool& pool, const int32_t* data, size_t count) {
+  if (count <= kSumGrain) {
+    return std::accumulate(data, data + count, int64_t{0});
+  }
+  size_t half = count / 2;
+  int64_t left = 0;
+  std::atomic<bool> done{false};
+  pool.Submit([&] {
+    left = Sum(pool, data, half);
+    done.store(true, std::memory_order_release);
+  });
+  int64_t right = Sum(pool, data + half, count - half);
+  HelpUntil(pool, done);
+  return left + right;
+}
+
+// 根任务也交给池子跑，主线程只是睡着等结果 (不占 CPU，不参与计算)
+template <typename Pool, typename Work>
+double Time(Pool& pool, Work work) {
+  std::atomic<bool> done{false};
+  auto start = std::chrono::steady_clock::now();
+  pool.Submit([&] {
+    work();
+    done.store(true, std::memory_order_release);
+    done.notify_one();
+  });
+  done.wait(false, std::memory_order_acquire);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename Pool>
+void Run(const char* name, int num_threads, const std::vector<int32_t>& data) {
+  Pool pool(num_threads);
+  long long fib = 0;
+  int64_t sum = 0;
+  double fib_ms = Time(pool, [&] { fib = Fib(pool, kFibN); });
+  double sum_ms = Time(pool, [&] { sum = Sum(pool, data.data(), data.size()); });
+  std::cout << "  " << name << " threads=" << num_threads << ": fib(" << kFibN << ") " << fib_ms << " ms, sum "
+            << sum_ms << " ms  (fib=" << fib << ", sum=" << sum << ")" << std::endl;
+}
+
+int main() {
+  std::cout << "=== Fork-Join Benchmark ===" << std::endl;
+  unsigned hardware = std::thread::hardware_concurrency();
+  std::cout << "hardware threads: " << hardware << std::endl;
+
+  std::vector<int32_t> data(kSumSize);
+  std::iota(data.begin(), data.end(), 0);
+
+  auto start = std::chrono::steady_clock::now();
+  long long serial_fib = SerialFib(kFibN);
+  auto middle = std::chrono::steady_clock::now();
+  int64_t serial_sum = std::accumulate(data.begin(), data.end(), int64_t{0});
+  auto end = std::chrono::steady_clock::now();
+  std::cout << "  serial: fib(" << kFibN << ") " << std::chrono::duration<double, std::milli>(middle - start).count()
+            << " ms, sum " << std::chrono::duration<double, std::milli>(end - middle).count() << " ms  (fib="
+            << serial_fib << ", sum=" << serial_sum << ")" << std::endl;
+
+  std::vector<int> thread_counts = {1, 2, 4};
+  if (hardware > 4) {
+    thread_counts.push_back(static_cast<int>(hardware));
+  }
+  for (int threads : thread_counts) {
+    Run<ThreadPool>("ThreadPool            ", threads, data);
+    Run<WorkStealingThreadPool>("WorkStealingThreadPool", threads, data);
+  }
+  return 0;
+}
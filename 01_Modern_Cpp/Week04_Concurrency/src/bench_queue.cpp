@@ -0,0 +1,96 @@
+// 队列吞吐量：ThreadSafeQueue (一把 mutex) vs MpmcQueue (无锁环形队列)
+// 1 个线程时自己 Push 再 Pop；多个线程时一半生产者、一半消费者
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "mpmc_queue.hpp"
+#include "thread_pool.hpp"
+#include "thread_safe_queue.hpp"
+
+const int kItems = 1000000;
+
+template <typename Queue>
+void Run(const char* name, int num_threads) {
+  Queue queue;
+  std::atomic<long long> sink{0};
+
+  auto start = std::chrono::steady_clock::now();
+  if (num_threads == 1) {
+    long long sum = 0;
+    for (int i = 0; i < kItems; ++i) {
+      queue.Push(i);
+      int value = 0;
+      queue.WaitAndPop(value);
+      sum += value;
+    }
+    sink = sum;
+  } else {
+    int pairs = num_threads / 2;
+    int per_thread = kItems / pairs;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < pairs; ++t) {
+      threads.emplace_back([&queue, per_thread] {
+        for (int i = 0; i < per_thread; ++i) {
+          queue.Push(i);
+        }
+      });
+      threads.emplace_back([&queue, &sink, per_thread] {
+        long long sum = 0;
+        for (int i = 0; i < per_thread; ++i) {
+          int value = 0;
+          queue.WaitAndPop(value);
+          sum += value;
+        }
+        sink.fetch_add(sum);
+      });
+    }
+    for (auto& th : threads) th.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "  " << name << " threads=" << num_threads << ": " << kItems / seconds / 1e6
+            << " M ops/sec  (sink=" << sink.load() << ")" << std::endl;
+}
+
+// 线程池：提交 kItems 个空任务，等它们全部跑完
+template <typename Pool>
+void RunPool(const char* name, int num_threads) {
+  std::atomic<int> done{0};
+  auto start = std::chrono::steady_clock::now();
+  {
+    Pool pool(num_threads);
+    for (int i = 0; i < kItems; ++i) {
+      pool.Submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    while (done.load() < kItems) {
+      std::this_thread::yield();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "  " << name << " workers=" << num_threads << ": " << kItems / seconds / 1e6 << " M tasks/sec"
+            << std::endl;
+}
+
+int main() {
+  std::cout << "=== Queue Throughput Benchmark ===" << std::endl;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+    Run<ThreadSafeQueue<int>>("ThreadSafeQueue", threads);
+    Run<MpmcQueue<int>>("MpmcQueue      ", threads);
+  }
+
+  std::cout << "--- ThreadPool ---" << std::endl;
+  for (int workers : {1, 4}) {
+    RunPool<ThreadPool>("ThreadPool (ThreadSafeQueue)", workers);
+    RunPool<BasicThreadPool<MpmcQueue>>("ThreadPool (MpmcQueue)      ", workers);
+  }
+  return 0;
+}
@@ -0,0 +1,96 @@
+// 单生产者单消费者交接吞吐量：ThreadSafeQueue vs SpscQueue (逐个 / 批量 / 阻塞模式)
+// 两个线程分别绑到 CPU 0 和 CPU 1 (只有一个核时都绑在 CPU 0，结果只能看相对值)
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <pthread.h>
+#include <sched.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "spsc_queue.hpp"
+#include "thread_safe_queue.hpp"
+
+const int kItems = 20000000;
+const int kBatch = 64;
+
+void PinToCpu(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % std::thread::hardware_concurrency(), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+template <typename Queue>
+void Report(const char* name, std::chrono::steady_clock::time_point start, long long sink) {
+  auto end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "  " << name << ": " << kItems / seconds / 1e6 << " M items/sec  (sink=" << sink << ")"
+            << std::endl;
+}
+
+// 逐个 Push / WaitAndPop
+template <typename Queue>
+void RunSingle(const char* name) {
+  Queue queue;
+  long long sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::thread consumer([&] {
+    PinToCpu(1);
+    long long sum = 0;
+    for (int i = 0; i < kItems; ++i) {
+      int value = 0;
+      queue.WaitAndPop(value);
+      sum += value;
+    }
+    sink = sum;
+  });
+  PinToCpu(0);
+  for (int i = 0; i < kItems; ++i) {
+    queue.Push(i);
+  }
+  consumer.join();
+  Report<Queue>(name, start, sink);
+}
+
+// 每次最多 kBatch 个：TryPushBulk / TryPopBulk
+template <typename Queue>
+void RunBulk(const char* name) {
+  Queue queue;
+  long long sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::thread consumer([&] {
+    PinToCpu(1);
+    long long sum = 0;
+    int batch[kBatch];
+    for (int received = 0; received < kItems;) {
+      size_t n = queue.TryPopBulk(batch, kBatch);
+      for (size_t i = 0; i < n; ++i) sum += batch[i];
+      received += static_cast<int>(n);
+      if (n == 0) std::this_thread::yield();
+    }
+    sink = sum;
+  });
+  PinToCpu(0);
+  int batch[kBatch];
+  for (int next = 0; next < kItems;) {
+    int count = 0;
+    for (; count < kBatch && next + count < kItems; ++count) batch[count] = next + count;
+    size_t pushed = queue.TryPushBulk(batch, count);
+    next += static_cast<int>(pushed);
+    if (pushed == 0) std::this_thread::yield();
+  }
+  consumer.join();
+  Report<Queue>(name, start, sink);
+}
+
+int main() {
+  std::cout << "=== SPSC Handoff Benchmark ===" << std::endl;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  RunSingle<ThreadSafeQueue<int>>("ThreadSafeQueue          ");
+  RunSingle<SpscQueue<int>>("SpscQueue (spin)         ");
+  RunSingle<SpscQueue<int, true>>("SpscQueue (blocking)     ");
+  RunBulk<SpscQueue<int>>("SpscQueue (bulk x64)     ");
+  return 0;
+}
@@ -0,0 +1,79 @@
+// 唤醒延迟：消费者在 WaitAndPop 里等着，生产者 Push 一个带时间戳的元素，量"Push 之前 -> WaitAndPop 返回"用了多久。
+// 一次只有一个元素在路上 (消费者取到后回一个 ack，生产者收到 ack、隔一段时间再发下一个)，量到的是纯唤醒延迟，没有排队。
+//   - 间隔 0      ：突发流量，消费者刚开始等下一个就来了 -> 自旋窗口内就能拿到，省掉一次 futex 唤醒
+//   - 间隔 5us    ：消费者多半已经自旋完睡下去了 -> 两种策略差不多
+//   - 间隔 200us  ：一直空闲 -> 都是睡下去再被叫醒
+// 自旋需要生产者和消费者同时在跑：只有一个核时 SpinThenParkWait 自动退化成 ParkWait，
+// 所以这里再放一个不看核数、总是自旋的策略作对照 (单核机器上它只会更慢)。
+// 建议用 Release 构建运行：cmake -DCMAKE_BUILD_TYPE=Release ..
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "thread_safe_queue.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct AlwaysSpinThenParkWait {
+  static int SpinIterations() { return 1024; }
+  static void Relax() { SpinThenParkWait::Relax(); }
+};
+
+// 忙等 gap：用 sleep_for 的话最短也要几十微秒 (定时器精度)
+void Pause(std::chrono::nanoseconds gap) {
+  if (gap >= std::chrono::microseconds(100)) {
+    std::this_thread::sleep_for(gap);
+    return;
+  }
+  auto until = Clock::now() + gap;
+  while (Clock::now() < until) {
+  }
+}
+
+template <typename Wait>
+void Run(const char* name, std::chrono::nanoseconds gap, int samples) {
+  ThreadSafeQueue<Clock::time_point, Wait> requests;
+  ThreadSafeQueue<int, Wait> acks;
+  std::vector<long long> latencies;
+  latencies.reserve(samples);
+
+  std::thread consumer([&] {
+    for (int i = 0; i < samples; ++i) {
+      Clock::time_point sent;
+      requests.WaitAndPop(sent);
+      latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sent).count());
+      acks.Push(i);
+    }
+  });
+
+  for (int i = 0; i < samples; ++i) {
+    Pause(gap);
+    requests.Push(Clock::now());
+    int ack = 0;
+    acks.WaitAndPop(ack);
+  }
+  consumer.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "  " << name << " gap=" << std::chrono::duration_cast<std::chrono::microseconds>(gap).count()
+            << "us: p50 " << latencies[samples / 2] << " ns, p99 " << latencies[samples * 99 / 100] << " ns"
+            << std::endl;
+}
+
+int main() {
+  std::cout << "=== ThreadSafeQueue Wakeup Latency Benchmark ===" << std::endl;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency()
+            << ", SpinThenParkWait spins: " << SpinThenParkWait::SpinIterations() << std::endl;
+
+  using std::chrono::microseconds;
+  const std::pair<microseconds, int> kCases[] = {
+      {microseconds(0), 50000}, {microseconds(5), 20000}, {microseconds(200), 2000}};
+  for (const auto& [gap, samples] : kCases) {
+    Run<ParkWait>("ParkWait              ", gap, samples);
+    Run<SpinThenParkWait>("SpinThenParkWait      ", gap, samples);
+    Run<AlwaysSpinThenParkWait>("AlwaysSpinThenParkWait", gap, samples);
+  }
+  return 0;
+}
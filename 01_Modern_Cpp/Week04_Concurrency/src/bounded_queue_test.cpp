@@ -0,0 +1,117 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.hpp"
+#include "thread_safe_queue.hpp"
+
+using namespace std::chrono_literals;
+
+int main() {
+  std::cout << "--- Bounded ThreadSafeQueue Test ---" << std::endl;
+  bool ok = true;
+
+  // 1. kReject：满了 Push / TryPush 都失败，dropped 计数
+  {
+    ThreadSafeQueue<int> queue(2, OverflowPolicy::kReject);
+    ok = ok && queue.Push(1) && queue.Push(2) && !queue.Push(3) && !queue.TryPush(4);
+    std::cout << "[Reject] size " << queue.size() << ", dropped " << queue.dropped() << std::endl;  // Expect: 2, 1
+    ok = ok && queue.size() == 2 && queue.dropped() == 1;
+  }
+
+  // 2. kDropOldest：挤掉最老的，留下最新的
+  {
+    ThreadSafeQueue<int> queue(3, OverflowPolicy::kDropOldest);
+    for (int i = 1; i <= 5; ++i) queue.Push(i);
+    std::vector<int> out;
+    queue.DrainAll(out);
+    std::cout << "[DropOldest] kept " << out[0] << " " << out[1] << " " << out[2] << ", dropped " << queue.dropped()
+              << std::endl;  // Expect: 3 4 5, 2
+    ok = ok && out == std::vector<int>{3, 4, 5} && queue.dropped() == 2;
+  }
+
+  // 3. kBlock：满了生产者等着，消费者取走一个它才能继续
+  {
+    ThreadSafeQueue<int> queue(1);
+    queue.Push(1);
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+      queue.Push(2);  // 阻塞，直到主线程取走 1
+      pushed = true;
+    });
+    std::this_thread::sleep_for(50ms);
+    bool blocked = !pushed.load();
+    int value = 0;
+    queue.WaitAndPop(value);
+    producer.join();
+    std::cout << "[Block] producer blocked while full: " << std::boolalpha << blocked << std::endl;  // Expect: true
+    ok = ok && blocked && pushed && value == 1 && queue.size() == 1;
+  }
+
+  // 4. PushFor / PopFor：超时返回 false
+  {
+    ThreadSafeQueue<int> queue(1);
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    bool popped = queue.PopFor(value, 20ms);
+    ok = ok && !popped && std::chrono::steady_clock::now() - start >= 20ms;
+    ok = ok && queue.PushFor(7, 20ms) && !queue.PushFor(8, 20ms) && queue.PopFor(value, 20ms) && value == 7;
+    const int lvalue = 9;  // 左值走 const T& 重载 (拷贝)
+    ok = ok && queue.PushFor(lvalue, 20ms) && queue.TryPop(value) && value == 9;
+    std::cout << "[Timed] PopFor on empty / PushFor on full timed out" << std::endl;
+  }
+
+  // 5. 有界线程池：worker 全忙、积压满了以后 TrySubmit 立刻失败
+  {
+    std::atomic<bool> release{false};
+    std::atomic<int> started{0};
+    std::atomic<int> done{0};
+    ThreadPool pool(1, 2);
+    auto slow = [&] {
+      started.fetch_add(1);
+      while (!release.load()) std::this_thread::sleep_for(1ms);
+      done.fetch_add(1);
+    };
+    pool.Submit(slow);
+    while (started.load() == 0) std::this_thread::sleep_for(1ms);  // 唯一的 worker 已经拿走它、卡住了
+    bool first = pool.TrySubmit(slow);   // 积压 1
+    bool second = pool.TrySubmit(slow);  // 积压 2
+    bool third = pool.TrySubmit(slow);   // 满了
+    std::cout << "[Pool] TrySubmit when full: " << std::boolalpha << third << std::endl;  // Expect: false
+    ok = ok && first && second && !third;
+    release = true;
+    while (done.load() < 3) std::this_thread::sleep_for(1ms);
+  }
+
+  // 6. 析构：worker 只在吃到药丸时下班，已经取出来的任务一定会跑；
+  //    队列容量比 worker 少、析构期间还有任务在 RunPendingTask (可能截走药丸)，析构也能正常结束
+  {
+    int lost_rounds = 0;
+    for (int round = 0; round < 200; ++round) {
+      std::atomic<int> done{0};
+      {
+        ThreadPool pool(4, 1);
+        for (int i = 0; i < 8; ++i) {
+          pool.Submit([&done] { done.fetch_add(1); });
+        }
+      }
+      lost_rounds += done.load() != 8 ? 1 : 0;
+    }
+    {
+      ThreadPool pool(2, 1);
+      pool.Submit([&pool] {
+        auto until = std::chrono::steady_clock::now() + 50ms;
+        while (std::chrono::steady_clock::now() < until) {
+          if (!pool.RunPendingTask()) std::this_thread::yield();
+        }
+      });
+    }
+    std::cout << "[Pool] rounds that lost a task on shutdown: " << lost_rounds << std::endl;  // Expect: 0
+    ok = ok && lost_rounds == 0;
+  }
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "epoch.hpp"
+
+// 统计还活着的节点，检查 Retire 的东西最后都真的释放了
+std::atomic<long long> g_live_nodes{0};
+
+struct Node {
+  explicit Node(int v) : value(v) { g_live_nodes.fetch_add(1, std::memory_order_relaxed); }
+  ~Node() { g_live_nodes.fetch_add(-1, std::memory_order_relaxed); }
+
+  int value;
+  Node* next = nullptr;
+};
+
+// --- 用法 1：无锁栈 (Treiber Stack) ---
+// Pop 摘下栈顶后不能立刻 delete：别的线程可能刚读到同一个栈顶，正要读 top->next
+class LockFreeStack {
+public:
+  ~LockFreeStack() {
+    int value = 0;
+    while (Pop(value)) {
+    }
+  }
+
+  void Push(int value) {
+    Node* node = new Node(value);
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  bool Pop(int& value) {
+    EpochGuard guard;  // 保护下面对 top->next 的读取
+    Node* top = head_.load(std::memory_order_acquire);
+    while (top != nullptr && !head_.compare_exchange_weak(top, top->next, std::memory_order_acquire,
+                                                          std::memory_order_acquire)) {
+    }
+    if (top == nullptr) {
+      return false;
+    }
+    value = top->value;
+    EpochManager::Instance().Retire(top);  // 等所有读者离场再 delete
+    return true;
+  }
+
+private:
+  std::atomic<Node*> head_{nullptr};
+};
+
+// --- 用法 2：读多写少的链表 (Copy-On-Write) ---
+// 写者每次整条换掉，读者不停从头遍历到尾
+const int kListLength = 16;
+
+Node* BuildList(int version) {
+  Node* head = nullptr;
+  for (int i = 0; i < kListLength; ++i) {
+    Node* node = new Node(version);
+    node->next = head;
+    head = node;
+  }
+  return head;
+}
+
+void RetireList(Node* head) {
+  while (head != nullptr) {
+    Node* next = head->next;
+    EpochManager::Instance().Retire(head);
+    head = next;
+  }
+}
+
+int main() {
+  std::cout << "--- Epoch-Based Reclamation Test ---" << std::endl;
+  EpochManager& epochs = EpochManager::Instance();
+  bool ok = true;
+
+  // 1. 4 个线程同时 Push / Pop
+  {
+    LockFreeStack stack;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&stack] {
+        int value = 0;
+        for (int i = 0; i < 100000; ++i) {
+          stack.Push(i);
+          if (!stack.Pop(value)) std::abort();
+        }
+      });
+    }
+    for (auto& th : threads) th.join();
+  }
+  epochs.Flush();
+  std::cout << "[Stack] live nodes after Flush: " << g_live_nodes.load()
+            << ", pending: " << epochs.pending() << std::endl;  // Expect: 0, 0
+  ok = ok && g_live_nodes.load() == 0 && epochs.pending() == 0;
+
+  // 2. 读者一直在遍历，写者不停换新链表：待回收的节点数要有上界，不能随写入次数一起涨
+  const int kUpdates = 5000;
+  std::atomic<Node*> list{BuildList(0)};
+  std::atomic<bool> done{false};
+  std::atomic<size_t> max_pending{0};
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      while (!done.load(std::memory_order_relaxed)) {
+        EpochGuard guard;
+        Node* head = list.load(std::memory_order_acquire);
+        int version = head->value;
+        int length = 0;
+        for (Node* node = head; node != nullptr; node = node->next) {
+          // 同一条链表上的版本号都一样；读到被释放的节点 (ASan 会报错) 或者别的版本就说明回收早了
+          if (node->value != version) std::abort();
+          ++length;
+        }
+        if (length != kListLength) std::abort();
+      }
+    });
+  }
+
+  std::thread writer([&] {
+    for (int version = 1; version <= kUpdates; ++version) {
+      Node* old = list.exchange(BuildList(version), std::memory_order_acq_rel);
+      RetireList(old);
+      size_t pending = epochs.pending();
+      if (pending > max_pending.load(std::memory_order_relaxed)) {
+        max_pending.store(pending, std::memory_order_relaxed);
+      }
+    }
+  });
+  writer.join();
+  done = true;
+  for (auto& th : readers) th.join();
+
+  // 没有回收时这里会等于 retired；有了上界，写者最多压着 kMaxLocalPending (+ 一次检查间隔) 个
+  const size_t retired = static_cast<size_t>(kUpdates) * kListLength;
+  std::cout << "[List] retired " << retired << " nodes, max pending: " << max_pending.load()
+            << std::endl;  // Expect: <= 1088
+  ok = ok && max_pending.load() <= EpochManager::kMaxLocalPending + EpochManager::kCollectThreshold;
+
+  RetireList(list.exchange(nullptr));
+  epochs.Flush();
+  std::cout << "[List] live nodes after Flush: " << g_live_nodes.load() << ", pending: " << epochs.pending()
+            << ", epoch: " << epochs.epoch() << std::endl;  // Expect: 0, 0
+  ok = ok && g_live_nodes.load() == 0 && epochs.pending() == 0;
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
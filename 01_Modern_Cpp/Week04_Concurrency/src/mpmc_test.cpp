@@ -0,0 +1,80 @@
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "mpmc_queue.hpp"
+#include "thread_pool.hpp"
+
+int main() {
+  std::cout << "--- MPMC Ring Queue Test ---" << std::endl;
+  bool ok = true;
+
+  // 1. 单线程：容量向上取整到 2 的幂，满了 TryPush 失败，空了 TryPop 失败
+  {
+    MpmcQueue<std::unique_ptr<int>> queue(5);
+    std::cout << "capacity(5) -> " << queue.capacity() << std::endl;  // Expect: 8
+    int pushed = 0;
+    while (queue.TryPush(std::make_unique<int>(pushed))) {
+      ++pushed;
+    }
+    std::unique_ptr<int> extra = std::make_unique<int>(99);
+    ok = ok && pushed == 8 && !queue.TryPush(std::move(extra)) && extra && *extra == 99;  // 失败时不会偷走 value
+
+    std::unique_ptr<int> value;
+    for (int i = 0; i < 8; ++i) {
+      ok = ok && queue.TryPop(value) && *value == i;  // FIFO
+    }
+    ok = ok && !queue.TryPop(value) && queue.Empty();
+  }
+
+  // 2. 4 个生产者、4 个消费者，队列很小 (经常满 / 空，会走到阻塞等待)：每个数恰好被取走一次
+  {
+    const int kPerProducer = 100000;
+    MpmcQueue<int> queue(16);
+    std::atomic<long long> sum{0};
+    std::atomic<int> count{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&queue] {
+        for (int i = 1; i <= kPerProducer; ++i) {
+          queue.Push(i);
+        }
+      });
+      threads.emplace_back([&] {
+        for (int i = 0; i < kPerProducer; ++i) {
+          int value = 0;
+          queue.WaitAndPop(value);
+          sum.fetch_add(value, std::memory_order_relaxed);
+          count.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+    for (auto& th : threads) th.join();
+
+    long long expected = 4LL * kPerProducer * (kPerProducer + 1) / 2;
+    std::cout << "popped " << count.load() << " items, sum " << sum.load() << " (expected " << expected << ")"
+              << std::endl;
+    ok = ok && count.load() == 4 * kPerProducer && sum.load() == expected && queue.Empty();
+  }
+
+  // 3. 线程池换成无锁队列
+  {
+    std::atomic<int> done{0};
+    {
+      BasicThreadPool<MpmcQueue> pool(4);
+      for (int i = 0; i < 10000; ++i) {
+        pool.Submit([&done] { done.fetch_add(1); });
+      }
+      while (done.load() < 10000) {
+        std::this_thread::yield();
+      }
+    }
+    std::cout << "BasicThreadPool<MpmcQueue> ran " << done.load() << " tasks" << std::endl;  // Expect: 10000
+    ok = ok && done.load() == 10000;
+  }
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -4,6 +4,7 @@
 #include <queue>
 #include <mutex>
 #include <chrono>  // 用于模拟耗时操作 (sleep)
+#include <thread>
 
 #include "thread_safe_queue.hpp"
 
@@ -78,5 +79,59 @@ int main() {
     std::cout << "❌ Queue is NOT empty! Logic error." << std::endl;
   }
 
+  // --- 批量接口：整批一次加锁 ---
+  Print("--- Batch Test ---");
+  std::vector<int> batch = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  g_queue.PushBulk(batch);
+
+  std::vector<int> out;
+  size_t first = g_queue.PopUpTo(4, out);   // 取前 4 个
+  size_t rest = g_queue.DrainAll(out);      // 剩下的一次全拿走
+  Print("PopUpTo(4): " + std::to_string(first) + ", DrainAll: " + std::to_string(rest));  // Expect: 4, 6
+
+  bool in_order = out.size() == batch.size();
+  for (size_t i = 0; in_order && i < out.size(); ++i) {
+    in_order = out[i] == batch[i];
+  }
+  if (in_order && g_queue.Empty()) {
+    std::cout << "✅ Batch operations kept FIFO order." << std::endl;
+  } else {
+    std::cout << "❌ Batch operations lost or reordered items." << std::endl;
+  }
+
+  // --- 等待策略：先自旋再睡 ---
+  // SpinThenParkWait 在单核机器上不自旋，这里用一个总是自旋的策略，保证自旋 -> 抢锁 -> 再睡这条路径被跑到
+  struct SpinAlways {
+    static int SpinIterations() { return 256; }
+    static void Relax() { SpinThenParkWait::Relax(); }
+  };
+  Print("--- Spin-Then-Park Test ---");
+  ThreadSafeQueue<int, SpinAlways> spin_queue;
+  const int kSpinItems = 20000;
+  long long spin_sum = 0;
+  std::vector<std::thread> spin_threads;
+  std::mutex sum_mutex;
+  for (int t = 0; t < 2; ++t) {
+    spin_threads.emplace_back([&] {
+      for (int i = 1; i <= kSpinItems; ++i) spin_queue.Push(i);
+    });
+    spin_threads.emplace_back([&] {
+      long long local = 0;
+      for (int i = 0; i < kSpinItems; ++i) {
+        int value = 0;
+        spin_queue.WaitAndPop(value);
+        local += value;
+      }
+      std::lock_guard<std::mutex> lock(sum_mutex);
+      spin_sum += local;
+    });
+  }
+  for (auto& th : spin_threads) th.join();
+  if (spin_sum == 2LL * kSpinItems * (kSpinItems + 1) / 2 && spin_queue.Empty()) {
+    std::cout << "✅ Spin-then-park delivered every item exactly once." << std::endl;
+  } else {
+    std::cout << "❌ Spin-then-park lost or duplicated items." << std::endl;
+  }
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "spsc_queue.hpp"
+
+const int kItems = 1000000;
+
+// 一个生产者、一个消费者：消费者必须按顺序拿到 0, 1, 2, ...，一个不少。
+// 同时第三个线程不停地看 size()：瞬时值可以不准，但不能回绕成一个巨大的数 (Empty() 会跟着出错)
+template <typename Queue>
+bool Transfer(const char* name, bool bulk) {
+  Queue queue(256);
+  bool in_order = true;
+  std::atomic<bool> done{false};
+  bool size_sane = true;
+
+  std::thread observer([&] {
+    while (!done.load(std::memory_order_acquire)) {
+      size_sane = size_sane && queue.size() <= static_cast<size_t>(kItems);
+    }
+  });
+
+  std::thread consumer([&] {
+    int expected = 0;
+    int batch[32];
+    while (expected < kItems) {
+      if (bulk) {
+        size_t n = queue.TryPopBulk(batch, 32);
+        for (size_t i = 0; i < n; ++i) {
+          in_order = in_order && batch[i] == expected++;
+        }
+        if (n == 0) std::this_thread::yield();
+      } else {
+        int value = 0;
+        queue.WaitAndPop(value);
+        in_order = in_order && value == expected++;
+      }
+    }
+  });
+
+  if (bulk) {
+    int batch[32];
+    for (int next = 0; next < kItems;) {
+      int count = 0;
+      for (; count < 32 && next + count < kItems; ++count) batch[count] = next + count;
+      size_t pushed = queue.TryPushBulk(batch, count);
+      next += static_cast<int>(pushed);
+      if (pushed == 0) std::this_thread::yield();
+    }
+  } else {
+    for (int i = 0; i < kItems; ++i) {
+      queue.Push(i);
+    }
+  }
+  consumer.join();
+  done.store(true, std::memory_order_release);
+  observer.join();
+
+  std::cout << name << ": " << (in_order ? "in order" : "OUT OF ORDER")
+            << (size_sane ? "" : ", size() wrapped around") << std::endl;
+  return in_order && size_sane && queue.Empty();
+}
+
+int main() {
+  std::cout << "--- SPSC Ring Queue Test ---" << std::endl;
+  bool ok = true;
+
+  // 1. 单线程：容量取整、满 / 空、批量读写、失败时不偷走 value
+  {
+    SpscQueue<std::unique_ptr<int>> queue(3);
+    std::cout << "capacity(3) -> " << queue.capacity() << std::endl;  // Expect: 4
+    std::unique_ptr<int> items[6];
+    for (int i = 0; i < 6; ++i) items[i] = std::make_unique<int>(i);
+    size_t pushed = queue.TryPushBulk(items, 6);
+    std::unique_ptr<int> extra = std::make_unique<int>(99);
+    ok = ok && pushed == 4 && items[4] && !queue.TryPush(std::move(extra)) && extra;
+
+    std::unique_ptr<int> out[8];
+    size_t popped = queue.TryPopBulk(out, 8);
+    ok = ok && popped == 4 && *out[0] == 0 && *out[3] == 3 && queue.Empty();
+    ok = ok && queue.TryPush(std::move(extra)) && queue.size() == 1;  // 剩一个留给析构函数
+  }
+
+  // 2. 两个线程：自旋模式 / 阻塞模式 / 批量
+  ok = Transfer<SpscQueue<int>>("spin     ", false) && ok;
+  ok = Transfer<SpscQueue<int, true>>("blocking ", false) && ok;
+  ok = Transfer<SpscQueue<int>>("bulk     ", true) && ok;
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.hpp"
+#include "thread_safe_queue.hpp"
+
+void PrintStats(const char* name, const QueueStats& stats) {
+  std::cout << "[" << name << "] depth " << stats.depth << ", high water " << stats.high_water << ", enqueued "
+            << stats.enqueued << ", dequeued " << stats.dequeued << ", p50 wait <= " << stats.LatencyPercentile(0.5)
+            << " ns, p99 wait <= " << stats.LatencyPercentile(0.99) << " ns, lock contended "
+            << stats.lock_contended << "/" << stats.lock_acquisitions << std::endl;
+}
+
+int main() {
+  std::cout << "--- Queue Telemetry Test ---" << std::endl;
+  bool ok = true;
+
+  // 1. 单线程：深度 / 高水位 / 排队时间
+  {
+    InstrumentedQueue<int> queue;
+    for (int i = 0; i < 3; ++i) {
+      queue.Push(i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    int value = 0;
+    queue.WaitAndPop(value);
+    QueueStats stats = queue.stats();
+    PrintStats("single", stats);  // Expect: depth 2, high water 3, p50 wait >= 2ms
+    ok = ok && stats.depth == 2 && stats.high_water == 3 && stats.enqueued == 3 && stats.dequeued == 1 &&
+         stats.LatencyPercentile(0.5) >= 2000000;
+
+    // DrainAll 在锁外记的排队时间也要合并回来
+    std::vector<int> out;
+    queue.DrainAll(out);
+    stats = queue.stats();
+    ok = ok && out.size() == 2 && stats.depth == 0 && stats.dequeued == 3;
+  }
+
+  // 2. 多线程：每次加锁都被统计，入队 == 出队
+  {
+    const int kPerThread = 50000;
+    InstrumentedQueue<int> queue;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&queue] {
+        for (int i = 0; i < kPerThread; ++i) queue.Push(i);
+      });
+      threads.emplace_back([&queue] {
+        std::vector<int> batch;
+        for (int received = 0; received < kPerThread;) {
+          batch.clear();
+          received += static_cast<int>(queue.WaitAndPopUpTo(kPerThread - received, batch));
+        }
+      });
+    }
+    for (auto& th : threads) th.join();
+    QueueStats stats = queue.stats();
+    PrintStats("4x4", stats);
+    ok = ok && stats.enqueued == 4 * kPerThread && stats.dequeued == stats.enqueued && stats.depth == 0 &&
+         stats.lock_acquisitions >= 4 * kPerThread && stats.lock_contended <= stats.lock_acquisitions;
+  }
+
+  // 3. 线程池：从外面看任务积压了多少、排了多久
+  {
+    std::atomic<int> done{0};
+    BasicThreadPool<InstrumentedQueue> pool(2);
+    for (int i = 0; i < 1000; ++i) {
+      pool.Submit([&done] { done.fetch_add(1); });
+    }
+    while (done.load() < 1000) {
+      std::this_thread::yield();
+    }
+    QueueStats stats = pool.queue_stats();
+    PrintStats("pool", stats);
+    ok = ok && stats.enqueued == 1000 && stats.dequeued == 1000 && stats.high_water >= 1;
+  }
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <thread>
+
+#include "thread_pool.hpp"
+#include "unique_function.hpp"
+
+// 统计堆分配次数：检查"放得进内联缓冲就不分配内存"
+std::atomic<long> g_allocations{0};
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// 统计还活着的可调用对象：移动、赋值、析构以后每个对象恰好析构一次
+std::atomic<int> g_live{0};
+
+template <size_t kBytes>
+struct Payload {
+  Payload() { g_live.fetch_add(1); }
+  Payload(Payload&& other) noexcept : value(other.value) { g_live.fetch_add(1); }
+  ~Payload() { g_live.fetch_sub(1); }
+
+  int value = 7;
+  char padding[kBytes - sizeof(int)] = {};
+};
+
+int main() {
+  std::cout << "--- UniqueFunction Test ---" << std::endl;
+  bool ok = true;
+  std::cout << "sizeof(UniqueFunction<void()>) = " << sizeof(UniqueFunction<void()>) << std::endl;  // Expect: 64
+  ok = ok && sizeof(UniqueFunction<void()>) == 64;
+
+  // 1. 只能移动的捕获 (unique_ptr)，能放进去、能调用、能返回值
+  {
+    auto number = std::make_unique<int>(41);
+    UniqueFunction<int(int)> add = [number = std::move(number)](int x) { return *number + x; };
+    ok = ok && add && add(1) == 42;
+
+    UniqueFunction<int(int)> moved = std::move(add);
+    ok = ok && add == nullptr && moved(2) == 43;
+    moved = nullptr;
+    ok = ok && !moved;
+  }
+
+  // 2. 40 字节的捕获：放在内联缓冲里，构造 / 移动都不分配内存
+  {
+    long before = g_allocations.load();
+    UniqueFunction<int()> small = [payload = Payload<40>()] { return payload.value; };
+    UniqueFunction<int()> moved = std::move(small);
+    long allocations = g_allocations.load() - before;
+    std::cout << "[Inline] allocations: " << allocations << std::endl;  // Expect: 0
+    ok = ok && allocations == 0 && moved() == 7 && g_live.load() == 1;
+  }
+  ok = ok && g_live.load() == 0;
+
+  // 3. 128 字节的捕获：放不下，构造时分配一次；之后移动只搬指针
+  {
+    long before = g_allocations.load();
+    UniqueFunction<int()> big = [payload = Payload<128>()] { return payload.value; };
+    long after_construct = g_allocations.load() - before;
+    UniqueFunction<int()> moved = std::move(big);
+    UniqueFunction<int()> other = [] { return 0; };
+    other = std::move(moved);  // 赋值时 other 原来的可调用对象要先析构
+    long allocations = g_allocations.load() - before;
+    std::cout << "[Heap] allocations: " << after_construct << " -> " << allocations << std::endl;  // Expect: 1 -> 1
+    ok = ok && after_construct == 1 && allocations == 1 && other() == 7 && g_live.load() == 1;
+  }
+  ok = ok && g_live.load() == 0;
+
+  // 4. mutable Lambda：可以改自己的捕获
+  {
+    UniqueFunction<int()> counter = [n = 0]() mutable { return ++n; };
+    counter();
+    ok = ok && counter() == 2;
+  }
+
+  // 5. 线程池：捕获 unique_ptr 的任务直接提交 (以前 std::function 编译不过)
+  {
+    std::atomic<int> sum{0};
+    {
+      ThreadPool pool(2);
+      for (int i = 1; i <= 100; ++i) {
+        pool.Submit([value = std::make_unique<int>(i), &sum] { sum.fetch_add(*value); });
+      }
+    }
+    std::cout << "[Pool] sum: " << sum.load() << std::endl;  // Expect: 5050
+    ok = ok && sum.load() == 5050;
+  }
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "chase_lev_deque.hpp"
+#include "work_stealing_pool.hpp"
+
+// fork-join：一半交给池子 (可能被别的 worker 偷走)，一半自己算，等子任务时边等边帮忙
+long long Fib(WorkStealingThreadPool& pool, int n) {
+  if (n < 2) {
+    return n;
+  }
+  if (n < 12) {
+    return Fib(pool, n - 1) + Fib(pool, n - 2);
+  }
+  long long left = 0;
+  std::atomic<bool> done{false};
+  pool.Submit([&] {
+    left = Fib(pool, n - 1);
+    done.store(true, std::memory_order_release);
+  });
+  long long right = Fib(pool, n - 2);
+  while (!done.load(std::memory_order_acquire)) {
+    if (!pool.RunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+  return left + right;
+}
+
+int main() {
+  std::cout << "--- Work-Stealing Test ---" << std::endl;
+  bool ok = true;
+
+  // 1. 单线程：主人后进先出，小偷先进先出，容量不够会自动扩容
+  {
+    ChaseLevDeque<int*> deque(4);
+    std::vector<int> values(100);
+    for (int i = 0; i < 100; ++i) {
+      values[i] = i;
+      deque.Push(&values[i]);
+    }
+    int* value = nullptr;
+    ok = ok && deque.size() == 100 && deque.Pop(value) && *value == 99;    // 底部
+    ok = ok && deque.Steal(value) && *value == 0 && deque.size() == 98;     // 顶部
+    while (deque.Pop(value)) {
+    }
+    ok = ok && deque.Empty() && !deque.Steal(value);
+  }
+
+  // 2. 主人一边 Push 一边 Pop，3 个小偷一直偷：每个元素恰好被拿走一次
+  {
+    const int kItems = 200000;
+    ChaseLevDeque<int*> deque(8);
+    std::vector<int> values(kItems);
+    std::unique_ptr<std::atomic<int>[]> taken(new std::atomic<int>[kItems]);
+    for (int i = 0; i < kItems; ++i) {
+      values[i] = i;
+      taken[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic<bool> owner_done{false};
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+      thieves.emplace_back([&] {
+        int* value = nullptr;
+        while (!owner_done.load(std::memory_order_acquire)) {
+          if (deque.Steal(value)) {
+            taken[*value].fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+    int* value = nullptr;
+    for (int i = 0; i < kItems; ++i) {
+      deque.Push(&values[i]);
+      if (i % 3 == 0 && deque.Pop(value)) {
+        taken[*value].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    while (deque.Pop(value)) {
+      taken[*value].fetch_add(1, std::memory_order_relaxed);
+    }
+    owner_done.store(true, std::memory_order_release);
+    for (auto& th : thieves) th.join();
+
+    int exactly_once = 0;
+    for (int i = 0; i < kItems; ++i) {
+      exactly_once += taken[i].load() == 1 ? 1 : 0;
+    }
+    std::cout << "[Deque] items taken exactly once: " << exactly_once << " / " << kItems << std::endl;
+    ok = ok && exactly_once == kItems;
+  }
+
+  // 3. 外部线程提交 + worker 里再提交 (进本地 deque)，析构前都要跑完
+  {
+    std::atomic<int> done{0};
+    {
+      WorkStealingThreadPool pool(4);
+      for (int i = 0; i < 1000; ++i) {
+        pool.Submit([&pool, &done] {
+          done.fetch_add(1);
+          for (int j = 0; j < 9; ++j) {
+            pool.Submit([&done] { done.fetch_add(1); });
+          }
+        });
+      }
+    }
+    std::cout << "[Pool] ran " << done.load() << " tasks" << std::endl;  // Expect: 10000
+    ok = ok && done.load() == 10000;
+  }
+
+  // 4. 递归 fork-join
+  {
+    WorkStealingThreadPool pool(4);
+    long long result = Fib(pool, 25);
+    std::cout << "[Pool] fib(25) = " << result << std::endl;  // Expect: 75025
+    ok = ok && result == 75025;
+  }
+
+  std::cout << (ok ? "✅ passed" : "❌ failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -4,20 +4,146 @@
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-template <typename T>
+#include "queue_telemetry.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// 有容量上限的队列满了以后，Push 怎么办
+enum class OverflowPolicy {
+  kBlock,       // 生产者等到有空位：把压力反推给上游 (比如 accept 循环不再接新连接)
+  kReject,      // 立刻返回 false，新元素不要了：调用方可以马上回一个"服务繁忙"
+  kDropOldest,  // 挤掉队头最老的元素，新元素照样放进去：只关心最新数据的场景 (行情、监控采样)
+};
+
+// 等待策略：WaitAndPop / WaitAndPopUpTo 发现队列空了以后怎么等 (模板参数，编译期选定)
+//   - ParkWait：直接睡在条件变量上 (原来的行为)。不烧 CPU，但每次唤醒都是一次 futex 系统调用 + 上下文切换
+//   - SpinThenParkWait：先不加锁地 pause 自旋一小段，盯着队列的元素个数，数据一到马上去拿；窗口过了还没来再睡。
+//     突发流量下下一个元素往往几百纳秒内就到，省掉了"睡下去 - 被叫醒"这一来一回；代价是每次等待多烧一小段 CPU。
+//     只有一个核时自旋毫无意义 (生产者根本跑不起来)，自动退化成 ParkWait
+// 自定义策略只要提供 static int SpinIterations() 和 static void Relax()
+struct ParkWait {
+  static constexpr int SpinIterations() { return 0; }
+  static void Relax() {}
+};
+
+struct SpinThenParkWait {
+  static int SpinIterations() {
+    static const int iterations = std::thread::hardware_concurrency() > 1 ? 1024 : 0;
+    return iterations;
+  }
+
+  // pause 告诉 CPU "我在自旋"：降低功耗，让出流水线给同核的超线程，退出循环时也不会因为内存序推测失败而清空流水线
+  static void Relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+  }
+};
+
+// 第三个模板参数 Telemetry 见 queue_telemetry.hpp：默认 NoQueueTelemetry，什么都不记，没有任何开销
+template <typename T, typename WaitStrategy = ParkWait, typename Telemetry = NoQueueTelemetry>
 class ThreadSafeQueue {
 public:
-  ThreadSafeQueue() {} // 构造函数
+  static constexpr size_t kUnbounded = SIZE_MAX;
 
-  // 生产者调用
-  void Push(T value) {
+  ThreadSafeQueue() {} // 构造函数：无界队列 (原来的行为)
+
+  // 有界队列：最多 capacity 个元素，满了按 policy 处理。
+  // 生产者比消费者快时，内存和排队延迟都有上限，过载时行为可预期，而不是一直涨到 OOM
+  explicit ThreadSafeQueue(size_t capacity, OverflowPolicy policy = OverflowPolicy::kBlock)
+      : capacity_(capacity), policy_(policy) {}
+
+  // 生产者调用。返回 false 表示队列满了、按 kReject 策略被拒绝 (无界队列总是返回 true)
+  bool Push(T value) {
+    size_t waiters = 0;
     {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(std::move(value)); // std::move 稍微优化一下性能
+      std::unique_lock<std::mutex> lock = Lock();
+      if (!MakeRoomLocked(lock)) {
+        return false;
+      }
+      EnqueueLocked(std::move(value)); // std::move 稍微优化一下性能
+      PublishSizeLocked();
+      waiters = not_empty_waiters_;
     }
-    // 关键！唤醒一个正在等待的消费者(放在锁外面通知也是可以的，甚至在某些情况下性能更好，但放在锁里面最简单直观)
-    cond_var_.notify_one();
+    // 关键！唤醒一个正在等待的消费者。
+    // 放在锁外面通知：被叫醒的消费者不会一醒来就撞上我们还没释放的锁、再睡一次；
+    // 锁里读到没有消费者在睡 (都在干活或者在自旋)，连 notify 都省掉
+    Notify(cond_var_, 1, waiters);
+    return true;
+  }
+
+  // 不等待：满了直接返回 false (不管是哪种策略)，value 原封不动
+  bool TryPush(T&& value) { return TryPushImpl(std::move(value)); }
+  bool TryPush(const T& value) { return TryPushImpl(value); }
+
+  // 最多等 timeout：这段时间里一直满就返回 false，value 原封不动 (不管是哪种策略，都按"等待"处理)
+  template <typename Rep, typename Period>
+  bool PushFor(T&& value, const std::chrono::duration<Rep, Period>& timeout) {
+    return PushForImpl(std::move(value), timeout);
+  }
+  template <typename Rep, typename Period>
+  bool PushFor(const T& value, const std::chrono::duration<Rep, Period>& timeout) {
+    return PushForImpl(value, timeout);
+  }
+
+  // 不管容量和溢出策略，直接放进去 (队列可以暂时超过 capacity)。只给控制消息用，比如线程池析构时的"毒药丸"：
+  // 它既不能被 kReject 拒掉、被 kDropOldest 挤掉，也不能在 kBlock 下干等空位
+  void ForcePush(T value) {
+    size_t waiters = 0;
+    {
+      std::unique_lock<std::mutex> lock = Lock();
+      EnqueueLocked(std::move(value));
+      PublishSizeLocked();
+      waiters = not_empty_waiters_;
+    }
+    Notify(cond_var_, 1, waiters);
+  }
+
+  // 生产者调用 ———— 批量放入：整批只加一次锁、只通知一次。返回实际放进去的个数
+  // 传右值 (比如 std::move(batch)) 时逐个 move，传左值时逐个拷贝
+  // 有界队列满了也按 policy 处理：kBlock 等空位，kReject 停在第一个放不下的元素
+  template <typename Range>
+  size_t PushBulk(Range&& items) {
+    size_t count = 0;
+    size_t waiters = 0;
+    {
+      std::unique_lock<std::mutex> lock = Lock();
+      for (auto&& item : items) {
+        if (policy_ == OverflowPolicy::kBlock && FullLocked() && not_empty_waiters_ > 0) {
+          // 要睡下去等空位了：先叫醒消费者，它们可能还在等这一批的第一个元素
+          PublishSizeLocked();
+          cond_var_.notify_all();
+        }
+        if (!MakeRoomLocked(lock)) {
+          break;
+        }
+        if constexpr (std::is_rvalue_reference_v<Range&&>) {
+          EnqueueLocked(std::move(item));
+        } else {
+          EnqueueLocked(item);
+        }
+        ++count;
+      }
+      PublishSizeLocked();
+      waiters = not_empty_waiters_;
+    }
+    // 放进去不止一个，可能够好几个消费者分：全叫醒
+    Notify(cond_var_, count, waiters);
+    return count;
   }
 
   // 消费者调用 ———— 等待并取出数据
@@ -25,7 +151,8 @@ public:
     // 这里必须用 std::unique_lock，不能用 std::lock_guard。
     //   lock_guard：死板，构造锁，析构解，中间不能动。
     //   unique_lock：灵活，可以随时手动 lock/unlock。cond_var_.wait 需要在睡觉前临时解锁，所以必须配合 unique_lock 使用。
-    std::unique_lock<std::mutex> lock(mutex_);
+    // defer_lock：先不上锁，SpinThenParkWait 要在锁外自旋一会儿
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
 
     // 当 queue 为空，返回 false ，wait 函数会立刻让当前线程“去睡觉”（阻塞），并释放锁。
     // 如果队列空，就睡觉 (wait)
@@ -33,13 +160,102 @@ public:
     // 1. 解锁 (让生产者能进去 push 数据)
     // 2. 睡觉 (阻塞当前线程)
     // 3. 醒来后自动重新上锁
-    cond_var_.wait(lock, [this] {  
-        return !queue_.empty();
-    });
+    WaitNotEmpty(lock);
 
     // 取出数据
-    value = std::move(queue_.front()); // move 优化性能
-    queue_.pop();
+    value = std::move(FrontLocked()); // move 优化性能
+    DequeueLocked(Telemetry::Now());
+    PublishSizeLocked();
+    size_t waiters = not_full_waiters_;
+    lock.unlock();
+    Notify(not_full_, 1, waiters);
+  }
+
+  // 不等待：空了返回 false
+  bool TryPop(T& value) {
+    size_t waiters = 0;
+    {
+      std::unique_lock<std::mutex> lock = Lock();
+      if (queue_.empty()) {
+        return false;
+      }
+      value = std::move(FrontLocked());
+      DequeueLocked(Telemetry::Now());
+      PublishSizeLocked();
+      waiters = not_full_waiters_;
+    }
+    Notify(not_full_, 1, waiters);
+    return true;
+  }
+
+  // 最多等 timeout：这段时间里一直是空的就返回 false。
+  // 不按 WaitStrategy 自旋：带超时的调用方本来就是准备好等一阵子的
+  template <typename Rep, typename Period>
+  bool PopFor(T& value, const std::chrono::duration<Rep, Period>& timeout) {
+    std::unique_lock<std::mutex> lock = Lock();
+    if (!ParkFor(cond_var_, lock, not_empty_waiters_, timeout, [this] { return !queue_.empty(); })) {
+      return false;
+    }
+    value = std::move(FrontLocked());
+    DequeueLocked(Telemetry::Now());
+    PublishSizeLocked();
+    size_t waiters = not_full_waiters_;
+    lock.unlock();
+    Notify(not_full_, 1, waiters);
+    return true;
+  }
+
+  // 消费者调用 ———— 批量取出：等到至少有一个，然后一次锁内最多取 max_count 个追加到 out，返回取到的个数
+  size_t WaitAndPopUpTo(size_t max_count, std::vector<T>& out) {
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    WaitNotEmpty(lock);
+    size_t count = PopLocked(max_count, out);
+    size_t waiters = not_full_waiters_;
+    lock.unlock();
+    Notify(not_full_, count, waiters);
+    return count;
+  }
+
+  // 不等待：一次锁内最多取 max_count 个追加到 out，队列空就返回 0
+  size_t PopUpTo(size_t max_count, std::vector<T>& out) {
+    size_t count = 0;
+    size_t waiters = 0;
+    {
+      std::unique_lock<std::mutex> lock = Lock();
+      count = PopLocked(max_count, out);
+      waiters = not_full_waiters_;
+    }
+    Notify(not_full_, count, waiters);
+    return count;
+  }
+
+  // 不等待：把整个内部容器换出来 (锁里只做一次 swap，O(1))，再在锁外把元素 move 到 out，返回个数
+  size_t DrainAll(std::vector<T>& out) {
+    std::queue<Entry> drained;
+    size_t waiters = 0;
+    Stamp now;
+    {
+      std::unique_lock<std::mutex> lock = Lock();
+      drained.swap(queue_);
+      now = Telemetry::Now();
+      PublishSizeLocked();
+      waiters = not_full_waiters_;
+    }
+    size_t count = drained.size();
+    Notify(not_full_, count, waiters);
+    out.reserve(out.size() + count);
+    // 排队时间也在锁外算：先记到一个局部的 Telemetry 里，最后再加锁合并一次 (只有开了遥测才有这次加锁)
+    Telemetry drained_telemetry;
+    while (!drained.empty()) {
+      drained_telemetry.OnDequeue(StampOf(drained.front()), now);
+      out.push_back(std::move(ValueOf(drained.front())));
+      drained.pop();
+    }
+    if constexpr (Telemetry::kEnabled) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      telemetry_.MergeDequeues(drained_telemetry);
+    }
+    return count;
   }
 
   // 辅助函数：判断是否为空 (要在锁里检查)
@@ -52,10 +268,233 @@ public:
     return queue_.empty();
   }
 
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  // 因为队列满了被拒绝 (kReject) 或被挤掉 (kDropOldest) 的元素个数
+  size_t dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+  }
+
+  // 遥测快照 (只有 Telemetry = QueueTelemetry 时才有这个接口)
+  QueueStats stats() const
+    requires Telemetry::kEnabled
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return telemetry_.Snapshot(queue_.size());
+  }
+
 private:
-  std::queue<T> queue_;
+  using Stamp = typename Telemetry::Stamp;
+
+  // 开了遥测，每个元素旁边带一个入队时间戳；没开就直接存 T，和原来完全一样
+  struct StampedValue {
+    template <typename U>
+    StampedValue(U&& v, Stamp stamp) : value(std::forward<U>(v)), enqueued(stamp) {}
+
+    T value;
+    Stamp enqueued;
+  };
+  using Entry = std::conditional_t<Telemetry::kEnabled, StampedValue, T>;
+
+  static T& ValueOf(Entry& entry) {
+    if constexpr (Telemetry::kEnabled) {
+      return entry.value;
+    } else {
+      return entry;
+    }
+  }
+
+  static Stamp StampOf(const Entry& entry) {
+    if constexpr (Telemetry::kEnabled) {
+      return entry.enqueued;
+    } else {
+      return {};
+    }
+  }
+
+  // 生产者 / 消费者加锁都走这里：开了遥测先 try_lock，失败就算一次争抢，再老老实实排队
+  std::unique_lock<std::mutex> Lock() {
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    LockCounted(lock);
+    return lock;
+  }
+
+  void LockCounted(std::unique_lock<std::mutex>& lock) {
+    if constexpr (Telemetry::kEnabled) {
+      bool contended = !lock.try_lock();
+      if (contended) {
+        lock.lock();
+      }
+      telemetry_.OnLock(contended);
+    } else {
+      lock.lock();
+    }
+  }
+
+  // 以下 *Locked 函数调用前必须已经持有 mutex_
+  template <typename U>
+  void EnqueueLocked(U&& value) {
+    if constexpr (Telemetry::kEnabled) {
+      queue_.emplace(std::forward<U>(value), Telemetry::Now());
+    } else {
+      queue_.push(std::forward<U>(value));
+    }
+    telemetry_.OnEnqueue(queue_.size());
+  }
+
+  T& FrontLocked() { return ValueOf(queue_.front()); }
+
+  // now 由调用方取：批量出队时整批只读一次时钟
+  void DequeueLocked(Stamp now) {
+    telemetry_.OnDequeue(StampOf(queue_.front()), now);
+    queue_.pop();
+  }
+
+
+  bool FullLocked() const { return queue_.size() >= capacity_; }
+
+  // 按策略腾出一个空位。返回 false 表示这个元素被拒绝
+  bool MakeRoomLocked(std::unique_lock<std::mutex>& lock) {
+    if (!FullLocked()) {
+      return true;
+    }
+    switch (policy_) {
+      case OverflowPolicy::kBlock:
+        Park(not_full_, lock, not_full_waiters_, [this] { return !FullLocked(); });
+        return true;
+      case OverflowPolicy::kReject:
+        ++dropped_;
+        return false;
+      case OverflowPolicy::kDropOldest:
+        queue_.pop();
+        ++dropped_;
+        return true;
+    }
+    return false;
+  }
+
+  template <typename U>
+  bool TryPushImpl(U&& value) {
+    size_t waiters = 0;
+    {
+      std::unique_lock<std::mutex> lock = Lock();
+      if (FullLocked()) {
+        return false;
+      }
+      EnqueueLocked(std::forward<U>(value));
+      PublishSizeLocked();
+      waiters = not_empty_waiters_;
+    }
+    Notify(cond_var_, 1, waiters);
+    return true;
+  }
+
+  template <typename U, typename Rep, typename Period>
+  bool PushForImpl(U&& value, const std::chrono::duration<Rep, Period>& timeout) {
+    size_t waiters = 0;
+    {
+      std::unique_lock<std::mutex> lock = Lock();
+      if (!ParkFor(not_full_, lock, not_full_waiters_, timeout, [this] { return !FullLocked(); })) {
+        return false;
+      }
+      EnqueueLocked(std::forward<U>(value));
+      PublishSizeLocked();
+      waiters = not_empty_waiters_;
+    }
+    Notify(cond_var_, 1, waiters);
+    return true;
+  }
+
+  // 给锁外自旋的消费者看的元素个数：只在锁里写，relaxed 就够了 (真正取数据前还是要拿锁、再检查一次)
+  void PublishSizeLocked() { size_hint_.store(queue_.size(), std::memory_order_relaxed); }
+
+  // 等到队列非空。传进来的 lock 还没上锁，返回时持有锁
+  void WaitNotEmpty(std::unique_lock<std::mutex>& lock) {
+    for (int i = WaitStrategy::SpinIterations(); i > 0; --i) {
+      if (size_hint_.load(std::memory_order_relaxed) > 0) {
+        break;
+      }
+      WaitStrategy::Relax();
+    }
+    LockCounted(lock);
+    // 自旋时看到的元素可能已经被别的消费者拿走了：照样按条件变量的规矩再检查、再睡
+    Park(cond_var_, lock, not_empty_waiters_, [this] { return !queue_.empty(); });
+  }
+
+  // 在条件变量上睡到 ready() 为真。睡之前在锁里登记 waiters，通知方据此决定要不要 notify
+  template <typename Predicate>
+  static void Park(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, size_t& waiters,
+                   Predicate ready) {
+    if (ready()) {
+      return;
+    }
+    ++waiters;
+    cv.wait(lock, ready);
+    --waiters;
+  }
+
+  template <typename Rep, typename Period, typename Predicate>
+  static bool ParkFor(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, size_t& waiters,
+                      const std::chrono::duration<Rep, Period>& timeout, Predicate ready) {
+    if (ready()) {
+      return true;
+    }
+    ++waiters;
+    bool ok = cv.wait_for(lock, timeout, ready);
+    --waiters;
+    return ok;
+  }
+
+  // 锁外调用：放进 / 取走了 count 个元素，叫醒等着的线程。
+  // waiters 是在锁里读到的等待人数：为 0 就什么都不做，不进内核 (无界队列永远没有人等空位)
+  static void Notify(std::condition_variable& cv, size_t count, size_t waiters) {
+    if (waiters == 0 || count == 0) {
+      return;
+    }
+    if (count == 1) {
+      cv.notify_one();
+    } else {
+      cv.notify_all();
+    }
+  }
+
+  size_t PopLocked(size_t max_count, std::vector<T>& out) {
+    size_t count = 0;
+    Stamp now = Telemetry::Now();
+    while (count < max_count && !queue_.empty()) {
+      out.push_back(std::move(FrontLocked()));
+      DequeueLocked(now);
+      ++count;
+    }
+    PublishSizeLocked();
+    return count;
+  }
+
+  std::queue<Entry> queue_;
   mutable std::mutex mutex_;  // mutable（可变的）。含义：“即使在一个 const 对象或 const 函数中，这个特定的变量依然允许被修改。”
-  std::condition_variable cond_var_;
+  std::condition_variable cond_var_;  // 不空了：叫醒消费者
+  std::condition_variable not_full_;  // 不满了：叫醒 (kBlock 策略下) 等空位的生产者
+  size_t not_empty_waiters_ = 0;      // 正睡在 cond_var_ 上的消费者个数 (锁里读写)
+  size_t not_full_waiters_ = 0;       // 正睡在 not_full_ 上的生产者个数 (锁里读写)
+  std::atomic<size_t> size_hint_{0};  // queue_.size() 的副本，见 PublishSizeLocked
+  [[no_unique_address]] Telemetry telemetry_;  // 默认的 NoQueueTelemetry 是空类，不占空间
+
+  size_t capacity_ = kUnbounded;
+  OverflowPolicy policy_ = OverflowPolicy::kBlock;
+  size_t dropped_ = 0;
 };
 
+// 给只接受 template <typename> class 的地方用 (比如 BasicThreadPool<SpinThenParkQueue>)
+template <typename T>
+using SpinThenParkQueue = ThreadSafeQueue<T, SpinThenParkWait>;
+
+template <typename T>
+using InstrumentedQueue = ThreadSafeQueue<T, ParkWait, QueueTelemetry>;
+
 #endif // Week04_Concurrency_INCLUDE_THREAD_SAFE_QUEUE_HPP
\ No newline at end of file
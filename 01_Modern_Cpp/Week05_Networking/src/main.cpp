@@ -76,26 +76,28 @@
 // ================================================  引入线程池 ================================================ 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <utility> // std::move
 #include <vector>
-#include <memory> // std::shared_ptr
 
 #include "Socket.hpp"
 #include "thread_pool.hpp"
 
 const int kPort = 8080;
-
-// 参数改为 shared_ptr，这样在 Lambda 里通过值传递 shared_ptr (拷贝)，
-// 就可以骗过 std::function 的“必须可拷贝”检查。
-void HandleClient(std::shared_ptr<Socket> client_sock) {
-    // 使用 -> 访问成员
-    int fd = client_sock->fd();
+const std::string_view kEchoPrefix = "Server Echo: ";
+// 最多积压多少个还没被 worker 接手的连接。再多就直接拒绝，而不是让队列 (和排队延迟) 无限涨
+const size_t kMaxPendingClients = 64;
+const std::string_view kBusyReply = "Server Busy\n";
+
+// 按值接收 Socket：连接的所有权一路 move 进来 (Accept -> Lambda -> 这里)，函数结束时析构、close(fd)
+void HandleClient(Socket client_sock) {
+    int fd = client_sock.fd();
     std::cout << "[Thread " << std::this_thread::get_id() << "] Handling client fd: " << fd << std::endl;
 
     try {
         char buffer[1024];
         while (true) {
-            // 使用 client_sock->fd()
-            ssize_t valread = ::read(client_sock->fd(), buffer, sizeof(buffer));
+            ssize_t valread = ::read(client_sock.fd(), buffer, sizeof(buffer));
             
             if (valread > 0) {
                 std::string msg(buffer, valread);
@@ -103,8 +105,12 @@ void HandleClient(std::shared_ptr<Socket> client_sock) {
 
                 std::cout << "[fd " << fd << "] Recv: " << msg << std::endl;
                 
-                std::string reply = "Server Echo: " + msg + "\n";
-                ::write(client_sock->fd(), reply.c_str(), reply.size());
+                // "Server Echo: " + msg + "\n" 会先生成一个临时串，再追加时可能二次扩容。
+                // 这里先按最终长度 reserve，一次分配拼完 (同 Week02 表达式模板的思路)
+                std::string reply;
+                reply.reserve(kEchoPrefix.size() + msg.size() + 1);
+                reply.append(kEchoPrefix).append(msg).push_back('\n');
+                ::write(client_sock.fd(), reply.c_str(), reply.size());
             } 
             else if (valread == 0) {
                 std::cout << "[fd " << fd << "] Client disconnected." << std::endl;
@@ -120,13 +126,14 @@ void HandleClient(std::shared_ptr<Socket> client_sock) {
     }
 
     std::cout << "[Thread " << std::this_thread::get_id() << "] Finished client fd: " << fd << std::endl;
-    // shared_ptr 计数归零，Socket 析构，自动 close(fd)
+    // client_sock 离开作用域，Socket 析构，自动 close(fd)
 }
 
 int main() {
     try {
-        ThreadPool pool(4);
-        std::cout << "ThreadPool started with 4 threads." << std::endl;
+        ThreadPool pool(4, kMaxPendingClients);
+        std::cout << "ThreadPool started with 4 threads, " << kMaxPendingClients << " pending clients max."
+                  << std::endl;
 
         Socket server;
         server.BindAddress(kPort);
@@ -136,17 +143,22 @@ int main() {
         while (true) {
             // 1. Accept 拿到一个右值 Socket
             Socket client = server.Accept();
-            
-            // 2. 错误 2 修正：
-            // 将 Socket 移动到 shared_ptr 中。
-            // shared_ptr 是可拷贝的，可以在 std::function 中传递。
-            auto client_ptr = std::make_shared<Socket>(std::move(client));
-
-            // 3. 将 shared_ptr 传入 Lambda
-            // 这里的 client_ptr 是按值捕获（发生了拷贝，引用计数+1）
-            pool.Submit([client_ptr]() {
-                HandleClient(client_ptr);
-            });
+            int fd = client.fd();
+
+            // 2. 把 Socket 直接 move 进 Lambda (C++14 的初始化捕获)。
+            // 线程池的 Task 是只能移动的 UniqueFunction，不再需要用 shared_ptr 去"骗过" std::function 的可拷贝检查；
+            // Lambda 只捕获了一个 Socket (一个 int)，放得进 Task 的内联缓冲：提交任务不分配内存。
+            // mutable：调用时要把捕获的 Socket 再 move 给 HandleClient
+            ThreadPool::Task task = [client = std::move(client)]() mutable {
+                HandleClient(std::move(client));
+            };
+
+            // 3. 过载时 (worker 全忙、积压已满) 不等待：立刻回一句 Busy 并关闭连接，accept 循环继续跑
+            // TrySubmit 失败时 task 原封不动，Socket 还活在 task 里，fd 仍然有效
+            if (!pool.TrySubmit(std::move(task))) {
+                std::cerr << "[fd " << fd << "] Rejected: too many pending clients." << std::endl;
+                ::write(fd, kBusyReply.data(), kBusyReply.size());
+            }  // 被拒绝时 task 离开作用域，里面的 Socket 析构，close(fd)
 
         }
     } catch (const std::exception& e) {